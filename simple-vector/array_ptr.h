@@ -2,81 +2,117 @@
 #include <cassert>
 #include <cstdlib>
 #include <utility>
+#include "buffer_pool.h"
+#include "simple_vector_config.h"
 template <typename Type>
 class ArrayPtr {
 public:
-    //  ArrayPtr  
+    // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
 
-    //      size   Type.
-    //  size == 0,  raw_ptr_    nullptr
-    explicit ArrayPtr(size_t size) {
+    // Создаёт в куче массив из size элементов типа Type.
+    // Если size == 0, поле raw_ptr_ должно быть равно nullptr
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size) {
         if (size > 0) {
             raw_ptr_ = new Type[size];
         }
     }
 
-    //    ,       nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept
+    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(Type* raw_ptr) noexcept
         :raw_ptr_(raw_ptr)
     {
 
     }
 
-    //  
+    // Запрещаем копирование
     ArrayPtr(const ArrayPtr&) = delete;
 
-    ArrayPtr(ArrayPtr&& other) {
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept {
         raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
     }
 
-    ArrayPtr& operator=(const ArrayPtr&& other) {
-        if (raw_ptr_ != nullptr) {
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& other) noexcept {
+        if (this != &other) {
             delete[] raw_ptr_;
+            raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
         }
-        raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+        return *this;
     }
 
-    ~ArrayPtr() {
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
         delete[] raw_ptr_;
     }
 
-    //  
+    // Запрещаем присваивание
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    //     ,    
-    //        
-    [[nodiscard]] Type* Release() noexcept {
+    // Создаёт массив из size элементов, беря его из пула буферов потока (BufferPool), если пул
+    // подключён и в нём есть массив такого размера. Элементы массива из пула имеют значение
+    // по умолчанию для нетривиальных Type и неопределённое - для тривиальных, как и у new Type[size]
+    SIMPLE_VECTOR_CONSTEXPR static ArrayPtr Allocate(size_t size) {
+        // Пустой массив не выделяет память и в статистику пула не попадает
+        if (size == 0) {
+            return ArrayPtr();
+        }
+        if (IsBufferPoolAvailable()) {
+            if (BufferPool<Type>* pool = BufferPool<Type>::Current()) {
+                if (Type* buffer = pool->Acquire(size)) {
+                    return ArrayPtr(buffer);
+                }
+            }
+        }
+        return ArrayPtr(size);
+    }
+
+    // Отдаёт массив из size элементов в пул буферов потока, а если пул его не принял - освобождает.
+    // После вызова указатель на массив обнуляется
+    SIMPLE_VECTOR_CONSTEXPR void Recycle(size_t size) noexcept {
+        if (raw_ptr_ != nullptr && IsBufferPoolAvailable()) {
+            if (BufferPool<Type>* pool = BufferPool<Type>::Current()) {
+                if (pool->Release(raw_ptr_, size)) {
+                    raw_ptr_ = nullptr;
+                    return;
+                }
+            }
+        }
+        delete[] raw_ptr_;
+        raw_ptr_ = nullptr;
+    }
+
+    // Прекращает владением массивом в памяти, возвращает значение адреса массива
+    // После вызова метода указатель на массив должен обнулиться
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept {
         Type* temp = raw_ptr_;
         raw_ptr_ = nullptr;
         return temp;
     }
 
-    //        index
-    Type& operator[](size_t index) noexcept {
+    // Возвращает ссылку на элемент массива с индексом index
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         return *(raw_ptr_ + index);
     }
 
-    //         index
-    const Type& operator[](size_t index) const noexcept {
+    // Возвращает константную ссылку на элемент массива с индексом index
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         return *(raw_ptr_ + index);
     }
 
-    //  true,   ,  false   
-    explicit operator bool() const {
+    // Возвращает true, если указатель ненулевой, и false в противном случае
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
         if (raw_ptr_ != nullptr) {
             return true;
         }
         return false;
     }
 
-    //    ,    
-    Type* Get() const noexcept {
+    // Возвращает значение сырого указателя, хранящего адрес начала массива
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    //        other
-    void swap(ArrayPtr& other) noexcept {
+    // Обменивается значениям указателя на массив с объектом other
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
         std::swap(raw_ptr_, other.raw_ptr_);
     }
 
@@ -0,0 +1,422 @@
+#pragma once
+#include "buffer_pool.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "incremental_vector.h"
+#include "packed_vector.h"
+#include "range_views.h"
+#include "simple_deque.h"
+#include "simple_vector.h"
+#include "static_simple_vector.h"
+#include "streaming_loader.h"
+#include "vector_expressions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Замеры производительности. Собираются вместе с тестами при определении SIMPLE_VECTOR_BENCHMARKS,
+// имеет смысл запускать только в оптимизированной сборке (-O2 -DNDEBUG)
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Выводит перцентили задержек одной операции в наносекундах
+inline void PrintLatencyPercentiles(const std::string& name, std::vector<long long>& latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+    };
+    std::cout << name << ": p50 "s << percentile(0.5) << " ns, p99 "s << percentile(0.99)
+        << " ns, p999 "s << percentile(0.999) << " ns, max "s << latencies.back() << " ns"s << std::endl;
+}
+
+template <typename Vector>
+void MeasurePushBackLatency(const std::string& name, Vector& v, size_t count) {
+    std::vector<long long> latencies;
+    latencies.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto start = BenchmarkClock::now();
+        v.PushBack(static_cast<int>(i));
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now() - start).count());
+    }
+    PrintLatencyPercentiles(name, latencies);
+}
+
+inline void BenchmarkPushBackLatency(size_t count = 10'000'000) {
+    std::cout << "BenchmarkPushBackLatency, "s << count << " elements"s << std::endl;
+    {
+        SimpleVector<int> v;
+        MeasurePushBackLatency("  SimpleVector"s, v, count);
+    }
+    {
+        IncrementalSimpleVector<int> v(8);
+        MeasurePushBackLatency("  IncrementalSimpleVector(8)"s, v, count);
+    }
+}
+
+// Возвращает время выполнения func в миллисекундах
+template <typename Func>
+double MeasureMilliseconds(Func func) {
+    const auto start = BenchmarkClock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+}
+
+// Сравнивает построение и поиск FlatMap с std::map и std::unordered_map.
+// Построение - из неупорядоченных пар, поиск - столько же запросов, половина из них промахи
+inline void BenchmarkFlatMapLookup(const std::vector<size_t>& sizes = { 1'000, 10'000, 100'000, 1'000'000 }) {
+    std::cout << "BenchmarkFlatMapLookup"s << std::endl;
+    std::mt19937_64 generator(42);
+    for (size_t size : sizes) {
+        std::vector<std::pair<uint64_t, uint64_t>> pairs(size);
+        for (auto& [key, value] : pairs) {
+            key = generator() % (2 * size);
+            value = key;
+        }
+        std::vector<uint64_t> queries(size);
+        for (uint64_t& query : queries) {
+            query = generator() % (2 * size);
+        }
+
+        uint64_t checksum = 0;
+        auto report = [&](const char* name, double build_ms, double lookup_ms) {
+            std::cout << "  "s << size << " keys, "s << name << ": build "s << build_ms << " ms, lookup "s
+                << queries.size() / lookup_ms / 1000 << " M/s"s << std::endl;
+        };
+        {
+            FlatMap<uint64_t, uint64_t> map;
+            const double build_ms = MeasureMilliseconds([&] { map = FlatMap<uint64_t, uint64_t>(pairs.begin(), pairs.end()); });
+            const double lookup_ms = MeasureMilliseconds([&] {
+                for (uint64_t query : queries) {
+                    const uint64_t* value = map.Find(query);
+                    checksum += value ? *value : 0;
+                }
+            });
+            report("FlatMap", build_ms, lookup_ms);
+        }
+        {
+            std::map<uint64_t, uint64_t> map;
+            const double build_ms = MeasureMilliseconds([&] { map.insert(pairs.begin(), pairs.end()); });
+            const double lookup_ms = MeasureMilliseconds([&] {
+                for (uint64_t query : queries) {
+                    const auto it = map.find(query);
+                    checksum += it != map.end() ? it->second : 0;
+                }
+            });
+            report("std::map", build_ms, lookup_ms);
+        }
+        {
+            std::unordered_map<uint64_t, uint64_t> map;
+            const double build_ms = MeasureMilliseconds([&] { map.insert(pairs.begin(), pairs.end()); });
+            const double lookup_ms = MeasureMilliseconds([&] {
+                for (uint64_t query : queries) {
+                    const auto it = map.find(query);
+                    checksum += it != map.end() ? it->second : 0;
+                }
+            });
+            report("std::unordered_map", build_ms, lookup_ms);
+        }
+        std::cout << "  checksum "s << checksum << std::endl;
+    }
+}
+
+// Очередь заданий: queue_size элементов, затем operations раз "взять из начала, положить в конец"
+template <typename Queue, typename PopFront>
+double MeasureQueue(size_t queue_size, size_t operations, PopFront pop_front) {
+    Queue queue;
+    for (size_t i = 0; i < queue_size; ++i) {
+        queue.PushBack(static_cast<int>(i));
+    }
+    return MeasureMilliseconds([&] {
+        for (size_t i = 0; i < operations; ++i) {
+            const int value = queue[0];
+            pop_front(queue);
+            queue.PushBack(value);
+        }
+    });
+}
+
+// Обёртка, дающая std::deque интерфейс PushBack
+struct StdDequeQueue {
+    void PushBack(int value) {
+        values.push_back(value);
+    }
+
+    int operator[](size_t index) const {
+        return values[index];
+    }
+
+    std::deque<int> values;
+};
+
+inline void BenchmarkDequeQueue(size_t operations = 100'000) {
+    std::cout << "BenchmarkDequeQueue, "s << operations << " operations"s << std::endl;
+    for (size_t queue_size : { 100u, 10'000u, 100'000u }) {
+        const double vector_ms = MeasureQueue<SimpleVector<int>>(queue_size, operations, [](auto& queue) {
+            queue.Erase(queue.begin());
+        });
+        const double deque_ms = MeasureQueue<SimpleDeque<int>>(queue_size, operations, [](auto& queue) {
+            queue.PopFront();
+        });
+        const double std_deque_ms = MeasureQueue<StdDequeQueue>(queue_size, operations, [](auto& queue) {
+            queue.values.pop_front();
+        });
+        std::cout << "  queue of "s << queue_size << ": SimpleVector::Erase(begin()) "s << vector_ms
+            << " ms, SimpleDeque "s << deque_ms << " ms, std::deque "s << std_deque_ms << " ms"s << std::endl;
+    }
+}
+
+template <typename Container, typename Scan>
+void ReportPackedScan(const char* name, const Container& container, size_t size, Scan scan) {
+    uint64_t sum = 0;
+    const double scan_ms = MeasureMilliseconds([&] {
+        sum = scan(container);
+    });
+    std::cout << "  "s << name << ": "s << static_cast<double>(container.MemoryUsage().used_bytes) / size
+        << " bytes/element, scan "s << size / scan_ms / 1000 << " M elements/s, sum "s << sum << std::endl;
+}
+
+// Сравнивает размер и скорость последовательного обхода SimpleVector<uint32_t> и сжатых векторов
+// на значениях из малого диапазона и на отсортированных идентификаторах
+inline void BenchmarkPackedVector(size_t size = 10'000'000) {
+    std::cout << "BenchmarkPackedVector, "s << size << " elements"s << std::endl;
+    std::mt19937 generator(42);
+    SimpleVector<uint32_t> small_range;
+    SimpleVector<uint32_t> sorted_ids;
+    small_range.Reserve(size);
+    sorted_ids.Reserve(size);
+    uint32_t id = 0;
+    for (size_t i = 0; i < size; ++i) {
+        small_range.PushBack(generator() % 4096);
+        id += 1 + generator() % 16;
+        sorted_ids.PushBack(id);
+    }
+
+    auto scan_vector = [](const SimpleVector<uint32_t>& values) {
+        return std::accumulate(values.begin(), values.end(), uint64_t{ 0 });
+    };
+    auto scan_packed = [](const auto& values) {
+        uint64_t sum = 0;
+        values.ForEach([&sum](uint32_t value) {
+            sum += value;
+        });
+        return sum;
+    };
+
+    std::cout << " values < 4096"s << std::endl;
+    ReportPackedScan("SimpleVector", small_range, size, scan_vector);
+    ReportPackedScan("PackedSimpleVector", PackedSimpleVector<uint32_t>::FromSimpleVector(small_range), size, scan_packed);
+    std::cout << " sorted ids"s << std::endl;
+    ReportPackedScan("SimpleVector", sorted_ids, size, scan_vector);
+    ReportPackedScan("PackedSimpleVector", PackedSimpleVector<uint32_t>::FromSimpleVector(sorted_ids), size, scan_packed);
+    ReportPackedScan("DeltaPackedSimpleVector", DeltaPackedSimpleVector<uint32_t>::FromSimpleVector(sorted_ids), size, scan_packed);
+}
+
+// Таблица CRC-32 из 256 значений: строится циклом с PushBack, как таблицы, создаваемые при запуске
+template <typename Table>
+constexpr Table MakeCrc32Table() {
+    Table table;
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        table.PushBack(crc);
+    }
+    return table;
+}
+
+inline constexpr auto kCrc32Table = MakeCrc32Table<StaticSimpleVector<uint32_t, 256>>();
+
+// Сравнивает стоимость "запуска": построение таблицы SimpleVector во время выполнения
+// против таблицы StaticSimpleVector, вычисленной при компиляции и лежащей в .rodata
+inline void BenchmarkStartupTable(size_t startups = 100'000) {
+    std::cout << "BenchmarkStartupTable, "s << startups << " startups"s << std::endl;
+    uint64_t checksum = 0;
+    const double runtime_ms = MeasureMilliseconds([&] {
+        for (size_t i = 0; i < startups; ++i) {
+            const auto table = MakeCrc32Table<SimpleVector<uint32_t>>();
+            checksum += table[i % 256];
+        }
+    });
+    const double constexpr_ms = MeasureMilliseconds([&] {
+        for (size_t i = 0; i < startups; ++i) {
+            const auto& table = kCrc32Table;
+            checksum += table[i % 256];
+        }
+    });
+    std::cout << "  SimpleVector at runtime "s << runtime_ms * 1'000'000 / startups
+        << " ns/startup, constexpr StaticSimpleVector "s << constexpr_ms * 1'000'000 / startups
+        << " ns/startup, checksum "s << checksum << std::endl;
+}
+
+// Конвейер "фильтр, преобразование, сборка": по шагам через промежуточные векторы
+// с PushBack и копированием результата против ленивых представлений и Collect
+inline void BenchmarkLazyPipeline(size_t size = 10'000'000, int repeats = 5) {
+    std::cout << "BenchmarkLazyPipeline, "s << size << " elements"s << std::endl;
+    SimpleVector<int> source(size);
+    std::iota(source.begin(), source.end(), 0);
+    auto is_even = [](int x) { return x % 2 == 0; };
+    auto scale = [](int x) { return x * 3 + 1; };
+
+    int64_t checksum = 0;
+    const double eager_ms = MeasureMilliseconds([&] {
+        for (int r = 0; r < repeats; ++r) {
+            SimpleVector<int> filtered;
+            for (int x : source) {
+                if (is_even(x)) {
+                    filtered.PushBack(x);
+                }
+            }
+            SimpleVector<int> transformed;
+            for (int x : filtered) {
+                transformed.PushBack(scale(x));
+            }
+            const SimpleVector<int> result = transformed;
+            checksum += result[result.GetSize() / 2];
+        }
+    });
+    const double lazy_ms = MeasureMilliseconds([&] {
+        for (int r = 0; r < repeats; ++r) {
+            const SimpleVector<int> result = source | Filter(is_even) | Transform(scale) | Collect();
+            checksum += result[result.GetSize() / 2];
+        }
+    });
+    std::cout << "  eager with temporaries "s << eager_ms / repeats << " ms, lazy views + Collect "s
+        << lazy_ms / repeats << " ms, checksum "s << checksum << std::endl;
+}
+
+// a + b * c: поэлементные операции с временным вектором на каждую операцию
+// против шаблонов выражений, вычисляющих результат одним циклом
+inline void BenchmarkVectorExpressions(size_t size = 10'000'000, int repeats = 5) {
+    std::cout << "BenchmarkVectorExpressions, "s << size << " elements"s << std::endl;
+    SimpleVector<double> a(size);
+    SimpleVector<double> b(size);
+    SimpleVector<double> c(size);
+    for (size_t i = 0; i < size; ++i) {
+        a[i] = static_cast<double>(i);
+        b[i] = static_cast<double>(i % 7);
+        c[i] = 0.5;
+    }
+    auto eager = [](const SimpleVector<double>& lhs, const SimpleVector<double>& rhs, auto op) {
+        SimpleVector<double> result(lhs.GetSize());
+        for (size_t i = 0; i < lhs.GetSize(); ++i) {
+            result[i] = op(lhs[i], rhs[i]);
+        }
+        return result;
+    };
+
+    double checksum = 0;
+    const double eager_ms = MeasureMilliseconds([&] {
+        for (int r = 0; r < repeats; ++r) {
+            const SimpleVector<double> product = eager(b, c, std::multiplies<>());
+            const SimpleVector<double> result = eager(a, product, std::plus<>());
+            checksum += result[size / 2];
+        }
+    });
+    const double expression_ms = MeasureMilliseconds([&] {
+        for (int r = 0; r < repeats; ++r) {
+            const SimpleVector<double> result = a + b * c;
+            checksum += result[size / 2];
+        }
+    });
+    std::cout << "  eager with temporaries "s << eager_ms / repeats << " ms, expression templates "s
+        << expression_ms / repeats << " ms, checksum "s << checksum << std::endl;
+}
+
+// Загрузка текстового файла с числами: построчное чтение std::ifstream с PushBack
+// против потокового загрузчика с перекрытием чтения и разбора
+inline void BenchmarkStreamingLoader(size_t count = 20'000'000) {
+    std::cout << "BenchmarkStreamingLoader, "s << count << " numbers"s << std::endl;
+    const auto path = std::filesystem::temp_directory_path() / "simple_vector_loader_benchmark.txt";
+    {
+        std::mt19937_64 generator(42);
+        std::ofstream out(path, std::ios::binary);
+        for (size_t i = 0; i < count; ++i) {
+            out << static_cast<int64_t>(generator() % 2'000'000'000) - 1'000'000'000 << '\n';
+        }
+    }
+    const double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1 << 20);
+
+    int64_t checksum = 0;
+    const double naive_ms = MeasureMilliseconds([&] {
+        std::ifstream in(path);
+        SimpleVector<int64_t> values;
+        std::string line;
+        while (std::getline(in, line)) {
+            values.PushBack(std::stoll(line));
+        }
+        checksum += values[count / 2];
+    });
+    const double streaming_ms = MeasureMilliseconds([&] {
+        const auto values = LoadTextNumbers<int64_t>(path);
+        checksum += values[count / 2];
+    });
+    StreamingLoadOptions options;
+    options.size_hint = count;
+    const double hinted_ms = MeasureMilliseconds([&] {
+        const auto values = LoadTextNumbers<int64_t>(path, options);
+        checksum += values[count / 2];
+    });
+    std::filesystem::remove(path);
+    std::cout << "  "s << megabytes << " MB: getline + PushBack "s << megabytes / naive_ms * 1000
+        << " MB/s, LoadTextNumbers "s << megabytes / streaming_ms * 1000
+        << " MB/s, with size_hint "s << megabytes / hinted_ms * 1000 << " MB/s, checksum "s << checksum << std::endl;
+}
+
+// Короткоживущие векторы обработчика запросов: создать, заполнить PushBack, уничтожить.
+// Возвращает число выделений буферов, подсчитанное по смене вместимости
+inline size_t CreateFillDestroy(size_t iterations, size_t elements, int64_t& checksum) {
+    size_t allocations = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        SimpleVector<int> v;
+        for (size_t j = 0; j < elements; ++j) {
+            const size_t capacity = v.GetCapacity();
+            v.PushBack(static_cast<int>(i + j));
+            allocations += v.GetCapacity() != capacity;
+        }
+        checksum += v[elements / 2];
+    }
+    return allocations;
+}
+
+inline void BenchmarkBufferPool(size_t iterations = 1'000'000, size_t elements = 200) {
+    std::cout << "BenchmarkBufferPool, "s << iterations << " vectors of "s << elements << " elements"s << std::endl;
+    int64_t checksum = 0;
+    size_t plain_allocations = 0;
+    const double plain_ms = MeasureMilliseconds([&] {
+        plain_allocations = CreateFillDestroy(iterations, elements, checksum);
+    });
+    BufferPool<int> pool;
+    const double pooled_ms = MeasureMilliseconds([&] {
+        BufferPoolScope<int> scope(pool);
+        CreateFillDestroy(iterations, elements, checksum);
+    });
+    const BufferPoolStats& stats = pool.GetStats();
+    std::cout << "  plain: "s << plain_allocations << " allocations, "s << iterations / plain_ms / 1000
+        << " M vectors/s"s << std::endl;
+    std::cout << "  pooled: "s << stats.misses + stats.bypassed << " allocations, "s << iterations / pooled_ms / 1000
+        << " M vectors/s, hit rate "s << stats.GetHitRate() << ", checksum "s << checksum << std::endl;
+}
+
+inline void RunBenchmarks() {
+    BenchmarkPushBackLatency();
+    BenchmarkFlatMapLookup();
+    BenchmarkDequeQueue();
+    BenchmarkPackedVector();
+    BenchmarkStartupTable();
+    BenchmarkLazyPipeline();
+    BenchmarkVectorExpressions();
+    BenchmarkStreamingLoader();
+    BenchmarkBufferPool(10'000'000, 16);
+    BenchmarkBufferPool();
+}
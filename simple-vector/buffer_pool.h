@@ -0,0 +1,199 @@
+#pragma once
+#include "simple_vector_config.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Статистика пула буферов
+struct BufferPoolStats {
+    // Запросы, обслуженные буфером из пула
+    size_t hits = 0;
+    // Запросы подходящего размера, для которых буфера в пуле не нашлось
+    size_t misses = 0;
+    // Запросы, которые пул не обслуживает (размер не степень двойки или больше предела)
+    size_t bypassed = 0;
+    // Буферы, принятые в пул
+    size_t returned = 0;
+    // Буферы, освобождённые из-за ограничений или Trim
+    size_t dropped = 0;
+
+    // Возвращает долю попаданий среди запросов подходящего размера
+    double GetHitRate() const noexcept {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+struct BufferPoolLimits {
+    // Наибольшее число свободных буферов одного размера
+    size_t max_buffers_per_class = 32;
+    // Наибольший размер одного хранимого буфера в байтах
+    size_t max_buffer_bytes = 64 * 1024;
+    // Наибольший суммарный размер хранимых буферов в байтах
+    size_t max_pooled_bytes = 4 * 1024 * 1024;
+};
+
+// Пул освобождённых массивов Type для ArrayPtr, разбитый на классы по размеру.
+// Класс k хранит массивы ровно из 2^k элементов - именно такие вместимости даёт рост
+// SimpleVector через PushBack (1, 2, 4, ...), поэтому короткоживущие векторы переиспользуют
+// буферы друг друга вместо обращений к куче. Массивы другого размера идут мимо пула.
+// Пул не потокобезопасен: он подключается к текущему потоку через BufferPoolScope,
+// и ArrayPtr::Allocate / ArrayPtr::Recycle обращаются к пулу своего потока
+template <typename Type>
+class BufferPool {
+public:
+    explicit BufferPool(BufferPoolLimits limits = {})
+        :limits_(limits)
+    {
+
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool() {
+        assert(current_ != this && "BufferPool destroyed while installed by BufferPoolScope");
+        Trim(0);
+    }
+
+    // Возвращает пул, подключённый к текущему потоку, либо nullptr
+    static BufferPool* Current() noexcept {
+        return current_;
+    }
+
+    // Возвращает массив из size элементов или nullptr, если подходящего буфера нет
+    Type* Acquire(size_t size) noexcept {
+        const int size_class = ClassOf(size);
+        if (size_class < 0) {
+            ++stats_.bypassed;
+            return nullptr;
+        }
+        auto& buffers = free_[size_class];
+        if (buffers.empty()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        Type* buffer = buffers.back();
+        buffers.pop_back();
+        pooled_bytes_ -= size * sizeof(Type);
+        return buffer;
+    }
+
+    // Принимает массив из size элементов. Возвращает false, если массив не подходит
+    // или пул заполнен; тогда массив остаётся у вызывающего
+    bool Release(Type* buffer, size_t size) noexcept {
+        const int size_class = ClassOf(size);
+        if (size_class < 0) {
+            return false;
+        }
+        auto& buffers = free_[size_class];
+        const size_t bytes = size * sizeof(Type);
+        if (buffers.size() >= limits_.max_buffers_per_class || pooled_bytes_ + bytes > limits_.max_pooled_bytes) {
+            ++stats_.dropped;
+            return false;
+        }
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            // Элементы не должны удерживать ресурсы, пока буфер лежит в пуле
+            for (size_t i = 0; i < size; ++i) {
+                buffer[i] = Type();
+            }
+        }
+        try {
+            buffers.push_back(buffer);
+        }
+        catch (...) {
+            ++stats_.dropped;
+            return false;
+        }
+        ++stats_.returned;
+        pooled_bytes_ += bytes;
+        return true;
+    }
+
+    // Освобождает буферы, начиная с самых крупных, пока в пуле не останется не более max_bytes
+    void Trim(size_t max_bytes = 0) noexcept {
+        for (size_t size_class = kClassCount; size_class-- > 0 && pooled_bytes_ > max_bytes;) {
+            auto& buffers = free_[size_class];
+            while (!buffers.empty() && pooled_bytes_ > max_bytes) {
+                delete[] buffers.back();
+                buffers.pop_back();
+                pooled_bytes_ -= (size_t{ 1 } << size_class) * sizeof(Type);
+                ++stats_.dropped;
+            }
+        }
+    }
+
+    // Возвращает суммарный размер хранимых буферов в байтах
+    size_t GetPooledBytes() const noexcept {
+        return pooled_bytes_;
+    }
+
+    const BufferPoolStats& GetStats() const noexcept {
+        return stats_;
+    }
+
+    void ResetStats() noexcept {
+        stats_ = {};
+    }
+
+private:
+    template <typename>
+    friend class BufferPoolScope;
+
+    static constexpr size_t kClassCount = sizeof(size_t) * 8;
+    // Нетривиальные элементы сбрасываются в Type() при возврате в пул, это не должно бросать исключений
+    static constexpr bool kPoolable = std::is_trivially_destructible_v<Type>
+        || (std::is_nothrow_default_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>);
+
+    // Возвращает номер класса для массива из size элементов либо -1
+    int ClassOf(size_t size) const noexcept {
+        if (!kPoolable || size == 0 || (size & (size - 1)) != 0 || size * sizeof(Type) > limits_.max_buffer_bytes) {
+            return -1;
+        }
+        int size_class = 0;
+        while ((size_t{ 1 } << size_class) < size) {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+    inline static thread_local BufferPool* current_ = nullptr;
+
+    BufferPoolLimits limits_;
+    std::array<std::vector<Type*>, kClassCount> free_;
+    size_t pooled_bytes_ = 0;
+    BufferPoolStats stats_;
+};
+
+// Подключает пул к текущему потоку на время своей жизни и восстанавливает предыдущий пул
+// при выходе из области видимости. Пул должен пережить BufferPoolScope
+template <typename Type>
+class BufferPoolScope {
+public:
+    explicit BufferPoolScope(BufferPool<Type>& pool) noexcept
+        :previous_(BufferPool<Type>::current_)
+    {
+        BufferPool<Type>::current_ = &pool;
+    }
+
+    BufferPoolScope(const BufferPoolScope&) = delete;
+    BufferPoolScope& operator=(const BufferPoolScope&) = delete;
+
+    ~BufferPoolScope() {
+        BufferPool<Type>::current_ = previous_;
+    }
+
+private:
+    BufferPool<Type>* previous_;
+};
+
+// Сообщает, можно ли обращаться к пулу: при вычислении на этапе компиляции пулов нет
+inline SIMPLE_VECTOR_CONSTEXPR bool IsBufferPoolAvailable() noexcept {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+    return !std::is_constant_evaluated();
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,213 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "simple_vector_config.h"
+
+// Аварийно завершает программу с диагностикой нарушенной проверки контейнера.
+// В отличие от assert срабатывает и в сборках с NDEBUG
+[[noreturn]] inline void SimpleVectorTrap(const char* message, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: SimpleVector check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+// Проверка предусловия контейнера.
+// В проверяемом режиме (SIMPLE_VECTOR_CHECKED_ITERATORS) работает всегда, иначе сводится к assert
+#ifdef SIMPLE_VECTOR_CHECKED_ITERATORS
+#define SIMPLE_VECTOR_CHECK(condition, message) \
+    ((condition) ? static_cast<void>(0) : SimpleVectorTrap((message), __FILE__, __LINE__))
+#else
+#define SIMPLE_VECTOR_CHECK(condition, message) assert((condition) && (message))
+#endif
+
+// Итератор произвольного доступа с проверкой границ и инвалидации.
+// Запоминает контейнер-владелец и его поколение на момент создания: контейнер увеличивает
+// поколение при каждой операции, инвалидирующей итераторы, и любое обращение
+// через устаревший итератор завершает программу с диагностикой.
+// Container должен предоставлять RawBegin(), RawEnd() и поле generation_
+template <typename Container, typename Value>
+class CheckedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
+    using value_type = std::remove_cv_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    CheckedIterator() noexcept = default;
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator(const Container* owner, Value* ptr) noexcept
+        :owner_(owner), generation_(owner->generation_), ptr_(ptr)
+    {
+
+    }
+
+    // Неконстантный итератор неявно преобразуется в константный
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value> && !std::is_const_v<Other>>>
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator(const CheckedIterator<Container, Other>& other) noexcept
+        :owner_(other.owner_), generation_(other.generation_), ptr_(other.ptr_)
+    {
+
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR reference operator*() const {
+        CheckDereferenceable();
+        return *ptr_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR pointer operator->() const {
+        CheckDereferenceable();
+        return ptr_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR reference operator[](difference_type offset) const {
+        return *(*this + offset);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator++() {
+        return *this += 1;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator++(int) {
+        CheckedIterator old = *this;
+        *this += 1;
+        return old;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator--() {
+        return *this -= 1;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator--(int) {
+        CheckedIterator old = *this;
+        *this -= 1;
+        return old;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator+=(difference_type offset) {
+        CheckValid();
+        const difference_type position = ptr_ - owner_->RawBegin() + offset;
+        SIMPLE_VECTOR_CHECK(position >= 0 && position <= owner_->RawEnd() - owner_->RawBegin(),
+            "iterator moved out of range");
+        ptr_ += offset;
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator-=(difference_type offset) {
+        return *this += -offset;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator+(CheckedIterator it, difference_type offset) {
+        return it += offset;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator+(difference_type offset, CheckedIterator it) {
+        return it += offset;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator-(CheckedIterator it, difference_type offset) {
+        return it -= offset;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ - rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ < rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return rhs < lhs;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(lhs < rhs);
+    }
+
+    // Сравнение с nullptr и приведение к bool повторяют поведение сырого указателя:
+    // итераторы пустого вектора равны nullptr
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator==(const CheckedIterator& it, std::nullptr_t) noexcept {
+        return it.ptr_ == nullptr;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator!=(const CheckedIterator& it, std::nullptr_t) noexcept {
+        return it.ptr_ != nullptr;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const noexcept {
+        return ptr_ != nullptr;
+    }
+
+    // Возвращает указатель на элемент без проверок
+    SIMPLE_VECTOR_CONSTEXPR Value* Base() const noexcept {
+        return ptr_;
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+    friend Container;
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckValid() const {
+        SIMPLE_VECTOR_CHECK(owner_ != nullptr, "iterator is not bound to a container");
+        SIMPLE_VECTOR_CHECK(generation_ == owner_->generation_,
+            "iterator invalidated by Reserve, Insert, Erase, Clear or swap");
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckDereferenceable() const {
+        CheckValid();
+        SIMPLE_VECTOR_CHECK(ptr_ >= owner_->RawBegin() && ptr_ < owner_->RawEnd(),
+            "dereferencing out-of-range iterator");
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckComparable(const CheckedIterator& other) const {
+        if (owner_ == nullptr && other.owner_ == nullptr) {
+            return;
+        }
+        SIMPLE_VECTOR_CHECK(owner_ == other.owner_, "comparing iterators of different containers");
+        CheckValid();
+        other.CheckValid();
+    }
+
+    const Container* owner_ = nullptr;
+    size_t generation_ = 0;
+    Value* ptr_ = nullptr;
+};
+
+#if __cplusplus >= 202002L
+// std::to_address для проверяемого итератора возвращает указатель без проверок,
+// в том числе для end(): этого требует std::contiguous_iterator
+template <typename Container, typename Value>
+struct std::pointer_traits<CheckedIterator<Container, Value>> {
+    using pointer = CheckedIterator<Container, Value>;
+    using element_type = Value;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr Value* to_address(const pointer& it) noexcept {
+        return it.Base();
+    }
+};
+#endif
@@ -0,0 +1,257 @@
+#pragma once
+#include "simple_vector.h"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченный ассоциативный массив на двух SimpleVector: отсортированном столбце ключей
+// и столбце значений с теми же индексами. Двоичный поиск идёт только по ключам, плотно
+// лежащим в памяти, значения читаются лишь для найденной позиции.
+// Позиция - индекс в столбцах: ключ GetKeys()[i] соответствует значению GetValues()[i]
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    FlatMap() = default;
+
+    explicit FlatMap(Compare comp)
+        :comp_(std::move(comp))
+    {
+
+    }
+
+    // Строит массив из неупорядоченного диапазона пар; из равных ключей остаётся первый
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, Compare comp = Compare())
+        :comp_(std::move(comp))
+    {
+        InsertBatch(first, last);
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, Compare comp = Compare())
+        :FlatMap(init.begin(), init.end(), std::move(comp))
+    {
+
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+        values_.Reserve(new_capacity);
+    }
+
+    // Возвращает позицию первого ключа, не меньшего key
+    size_t LowerBound(const Key& key) const {
+        return static_cast<size_t>(std::lower_bound(keys_.cbegin(), keys_.cend(), key, comp_) - keys_.cbegin());
+    }
+
+    // Возвращает указатель на значение ключа key либо nullptr
+    Value* Find(const Key& key) {
+        const size_t pos = FindPosition(key);
+        return pos == keys_.GetSize() ? nullptr : &values_[pos];
+    }
+
+    const Value* Find(const Key& key) const {
+        const size_t pos = FindPosition(key);
+        return pos == keys_.GetSize() ? nullptr : &values_[pos];
+    }
+
+    bool Contains(const Key& key) const {
+        return FindPosition(key) != keys_.GetSize();
+    }
+
+    // Возвращает ссылку на значение ключа key
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    Value& At(const Key& key) {
+        Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("Key is not found!"s);
+        }
+        return *value;
+    }
+
+    const Value& At(const Key& key) const {
+        const Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("Key is not found!"s);
+        }
+        return *value;
+    }
+
+    // Возвращает ссылку на значение ключа key, при необходимости вставляя значение по умолчанию
+    Value& operator[](const Key& key) {
+        const size_t pos = LowerBound(key);
+        if (pos == keys_.GetSize() || comp_(key, keys_[pos])) {
+            InsertAt(pos, key, Value());
+        }
+        return values_[pos];
+    }
+
+    // Вставляет пару, если ключа ещё нет. Возвращает позицию ключа и признак вставки
+    std::pair<size_t, bool> Insert(Key key, Value value) {
+        const size_t pos = LowerBound(key);
+        if (pos != keys_.GetSize() && !comp_(key, keys_[pos])) {
+            return { pos, false };
+        }
+        InsertAt(pos, std::move(key), std::move(value));
+        return { pos, true };
+    }
+
+    // Добавляет пары из неупорядоченного диапазона: одна сортировка пакета по ключам и одно слияние
+    // со столбцами. Имеющиеся ключи сохраняют свои значения; из равных ключей пакета берётся первый
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last) {
+        SimpleVector<Key> batch_keys;
+        SimpleVector<Value> batch_values;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            batch_keys.Reserve(count);
+            batch_values.Reserve(count);
+        }
+        for (; first != last; ++first) {
+            batch_keys.PushBack(first->first);
+            batch_values.PushBack(first->second);
+        }
+        MergeSorted(SortColumns(std::move(batch_keys), std::move(batch_values)));
+    }
+
+    // Добавляет все пары other, которых ещё нет
+    void Merge(const FlatMap& other) {
+        if (this == &other) {
+            return;
+        }
+        MergeSorted(FlatMap(other));
+    }
+
+    // Удаляет ключ key. Возвращает количество удалённых пар
+    size_t Erase(const Key& key) {
+        const size_t pos = FindPosition(key);
+        if (pos == keys_.GetSize()) {
+            return 0;
+        }
+        EraseAt(pos);
+        return 1;
+    }
+
+    // Удаляет пару в позиции pos
+    void EraseAt(size_t pos) {
+        keys_.Erase(keys_.cbegin() + pos);
+        values_.Erase(values_.cbegin() + pos);
+    }
+
+    // Возвращает ключи в порядке возрастания
+    const SimpleVector<Key>& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    // Возвращает значения в порядке возрастания ключей
+    const SimpleVector<Value>& GetValues() const noexcept {
+        return values_;
+    }
+
+    MemoryUsageInfo MemoryUsage() const {
+        MemoryUsageInfo usage = keys_.MemoryUsage();
+        usage += values_.MemoryUsage();
+        return usage;
+    }
+
+private:
+    size_t FindPosition(const Key& key) const {
+        const size_t pos = LowerBound(key);
+        if (pos != keys_.GetSize() && !comp_(key, keys_[pos])) {
+            return pos;
+        }
+        return keys_.GetSize();
+    }
+
+    // Если вставка значения выбросила исключение, вставленный ключ удаляется,
+    // чтобы столбцы остались одной длины
+    template <typename K, typename V>
+    void InsertAt(size_t pos, K&& key, V&& value) {
+        keys_.Insert(keys_.cbegin() + pos, std::forward<K>(key));
+        try {
+            values_.Insert(values_.cbegin() + pos, std::forward<V>(value));
+        }
+        catch (...) {
+            keys_.Erase(keys_.cbegin() + pos);
+            throw;
+        }
+    }
+
+    // Упорядочивает столбцы по ключам одной сортировкой индексов и удаляет повторы ключей
+    FlatMap SortColumns(SimpleVector<Key> keys, SimpleVector<Value> values) const {
+        SimpleVector<size_t> order(keys.GetSize());
+        for (size_t i = 0; i < order.GetSize(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this, &keys](size_t lhs, size_t rhs) {
+            return comp_(keys[lhs], keys[rhs]);
+        });
+        FlatMap result(comp_);
+        result.Reserve(order.GetSize());
+        for (size_t i : order) {
+            if (result.IsEmpty() || comp_(result.keys_[result.GetSize() - 1], keys[i])) {
+                result.keys_.PushBack(std::move(keys[i]));
+                result.values_.PushBack(std::move(values[i]));
+            }
+        }
+        return result;
+    }
+
+    // Сливает с упорядоченным массивом без повторов; при равных ключах остаётся своё значение
+    void MergeSorted(FlatMap&& other) {
+        if (other.IsEmpty()) {
+            return;
+        }
+        FlatMap result(comp_);
+        result.Reserve(GetSize() + other.GetSize());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < GetSize() || j < other.GetSize()) {
+            if (j == other.GetSize() || (i < GetSize() && !comp_(other.keys_[j], keys_[i]))) {
+                if (j < other.GetSize() && !comp_(keys_[i], other.keys_[j])) {
+                    ++j;
+                }
+                result.keys_.PushBack(std::move(keys_[i]));
+                result.values_.PushBack(std::move(values_[i]));
+                ++i;
+            }
+            else {
+                result.keys_.PushBack(std::move(other.keys_[j]));
+                result.values_.PushBack(std::move(other.values_[j]));
+                ++j;
+            }
+        }
+        keys_.swap(result.keys_);
+        values_.swap(result.values_);
+    }
+
+    SimpleVector<Key> keys_;
+    SimpleVector<Value> values_;
+    Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+bool operator==(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return lhs.GetKeys() == rhs.GetKeys() && lhs.GetValues() == rhs.GetValues();
+}
+
+template <typename Key, typename Value, typename Compare>
+bool operator!=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs == rhs);
+}
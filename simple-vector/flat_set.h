@@ -0,0 +1,160 @@
+#pragma once
+#include "simple_vector.h"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченное множество на отсортированном SimpleVector.
+// Поиск - двоичный по непрерывному массиву, без узлов и указателей, поэтому подходит
+// для таблиц, которые часто читаются и редко перестраиваются. Вставка и удаление
+// одного ключа - O(n), массовое построение и слияние - одна сортировка и удаление дубликатов
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+public:
+    using ConstIterator = typename SimpleVector<Key>::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(Compare comp)
+        :comp_(std::move(comp))
+    {
+
+    }
+
+    // Строит множество из неупорядоченного диапазона; из равных ключей остаётся первый
+    template <typename InputIt>
+    FlatSet(InputIt first, InputIt last, Compare comp = Compare())
+        :comp_(std::move(comp))
+    {
+        InsertBatch(first, last);
+    }
+
+    FlatSet(std::initializer_list<Key> init, Compare comp = Compare())
+        :FlatSet(init.begin(), init.end(), std::move(comp))
+    {
+
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    // Возвращает итератор на первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const {
+        return std::lower_bound(keys_.cbegin(), keys_.cend(), key, comp_);
+    }
+
+    // Возвращает итератор на ключ, равный key, либо end()
+    ConstIterator Find(const Key& key) const {
+        const auto it = LowerBound(key);
+        if (it != keys_.cend() && !comp_(key, *it)) {
+            return it;
+        }
+        return keys_.cend();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != keys_.cend();
+    }
+
+    // Вставляет key, если его ещё нет. Возвращает итератор на ключ и признак вставки
+    std::pair<ConstIterator, bool> Insert(Key key) {
+        const auto it = LowerBound(key);
+        if (it != keys_.cend() && !comp_(key, *it)) {
+            return { it, false };
+        }
+        return { keys_.Insert(it, std::move(key)), true };
+    }
+
+    // Добавляет ключи из неупорядоченного диапазона за одну сортировку пакета и одно слияние.
+    // Ключи, уже имеющиеся в множестве, сохраняются; из равных ключей пакета берётся первый
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last) {
+        const size_t old_size = keys_.GetSize();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>) {
+            keys_.Reserve(old_size + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            keys_.PushBack(*first);
+        }
+        const auto middle = keys_.begin() + old_size;
+        std::stable_sort(middle, keys_.end(), comp_);
+        std::inplace_merge(keys_.begin(), middle, keys_.end(), comp_);
+        RemoveDuplicates();
+    }
+
+    // Добавляет все ключи other
+    void Merge(const FlatSet& other) {
+        if (this == &other) {
+            return;
+        }
+        InsertBatch(other.begin(), other.end());
+    }
+
+    // Удаляет ключ, равный key. Возвращает количество удалённых ключей
+    size_t Erase(const Key& key) {
+        const auto it = Find(key);
+        if (it == keys_.cend()) {
+            return 0;
+        }
+        keys_.Erase(it);
+        return 1;
+    }
+
+    ConstIterator Erase(ConstIterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.cbegin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.cend();
+    }
+
+    // Возвращает ключи в порядке возрастания
+    const SimpleVector<Key>& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    MemoryUsageInfo MemoryUsage() const {
+        return keys_.MemoryUsage();
+    }
+
+private:
+    void RemoveDuplicates() {
+        const auto new_end = std::unique(keys_.begin(), keys_.end(), [this](const Key& lhs, const Key& rhs) {
+            return !comp_(lhs, rhs);
+        });
+        keys_.Resize(static_cast<size_t>(new_end - keys_.begin()));
+    }
+
+    SimpleVector<Key> keys_;
+    Compare comp_;
+};
+
+template <typename Key, typename Compare>
+bool operator==(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return lhs.GetKeys() == rhs.GetKeys();
+}
+
+template <typename Key, typename Compare>
+bool operator!=(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include "array_ptr.h"
+#include "checked_iterator.h"
+#include "index_iterator.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace std::literals;
+
+// Вектор с пошаговым ростом для путей, чувствительных к задержке.
+// При переполнении выделяется буфер вдвое больше, но элементы переносятся в него не сразу:
+// каждый следующий PushBack переносит не более migration_step элементов, поэтому ни одна операция
+// не выполняет больше O(migration_step) перемещений. Пока идёт перенос, элементы с индексами
+// из [migrated_, old_size_) находятся в старом буфере, остальные - в новом.
+// Буферы выделяются через new Type[n] и освобождаются через delete[] единовременно,
+// поэтому Type обязан иметь тривиальные конструктор по умолчанию и деструктор:
+// иначе одна вставка конструировала бы или разрушала все элементы буфера
+template <typename Type>
+class IncrementalSimpleVector {
+    static_assert(std::is_trivially_default_constructible_v<Type> && std::is_trivially_destructible_v<Type>,
+        "IncrementalSimpleVector requires a trivially default constructible and trivially destructible Type");
+
+public:
+    using Iterator = IndexIterator<IncrementalSimpleVector, Type>;
+    using ConstIterator = IndexIterator<IncrementalSimpleVector, const Type>;
+
+    // migration_step - сколько элементов переносит из старого буфера каждый PushBack.
+    // При migration_step >= 1 перенос всегда завершается раньше, чем заполнится новый буфер
+    explicit IncrementalSimpleVector(size_t migration_step = 8)
+        :migration_step_(std::max(static_cast<size_t>(1u), migration_step))
+    {
+
+    }
+
+    IncrementalSimpleVector(const IncrementalSimpleVector&) = delete;
+    IncrementalSimpleVector& operator=(const IncrementalSimpleVector&) = delete;
+
+    IncrementalSimpleVector(IncrementalSimpleVector&& other) noexcept {
+        swap(other);
+    }
+
+    IncrementalSimpleVector& operator=(IncrementalSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость нового буфера
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, есть ли ещё элементы в старом буфере
+    bool IsMigrating() const noexcept {
+        return migrated_ < old_size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushBack(const Type& value) {
+        PrepareSlot();
+        array_[size_] = value;
+        ++size_;
+    }
+
+    void PushBack(Type&& value) {
+        PrepareSlot();
+        array_[size_] = std::move(value);
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "PopBack on empty vector");
+        --size_;
+        old_size_ = std::min(old_size_, size_);
+        migrated_ = std::min(migrated_, old_size_);
+        if (!IsMigrating()) {
+            ReleaseOldBuffer();
+        }
+    }
+
+    // Обнуляет размер массива, не изменяя вместимость нового буфера
+    void Clear() noexcept {
+        size_ = 0;
+        ReleaseOldBuffer();
+    }
+
+    // Переносит все оставшиеся элементы старого буфера за один вызов
+    void FinishMigration() {
+        Migrate(old_size_ - migrated_);
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return InOldBuffer(index) ? old_array_[index] : array_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return InOldBuffer(index) ? old_array_[index] : array_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return (*this)[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return (*this)[index];
+    }
+
+    void swap(IncrementalSimpleVector& other) noexcept {
+        array_.swap(other.array_);
+        old_array_.swap(other.old_array_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(migrated_, other.migrated_);
+        std::swap(old_size_, other.old_size_);
+        std::swap(migration_step_, other.migration_step_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+private:
+    bool InOldBuffer(size_t index) const noexcept {
+        return index >= migrated_ && index < old_size_;
+    }
+
+    // Переносит очередную порцию элементов и освобождает место под новый элемент
+    void PrepareSlot() {
+        if (size_ == capacity_) {
+            // При migration_step_ >= 1 к этому моменту перенос уже завершён, вызов - страховка
+            FinishMigration();
+            StartMigration(std::max(static_cast<size_t>(1u), 2 * capacity_));
+        }
+        Migrate(migration_step_);
+    }
+
+    void StartMigration(size_t new_capacity) {
+        ArrayPtr<Type> temp(new_capacity);
+        temp.swap(array_);
+        old_array_.swap(temp);
+        capacity_ = new_capacity;
+        migrated_ = 0;
+        old_size_ = size_;
+        if (!IsMigrating()) {
+            ReleaseOldBuffer();
+        }
+    }
+
+    void Migrate(size_t count) {
+        if (!IsMigrating()) {
+            return;
+        }
+        const size_t last = std::min(old_size_, migrated_ + count);
+        std::move(old_array_.Get() + migrated_, old_array_.Get() + last, array_.Get() + migrated_);
+        migrated_ = last;
+        if (!IsMigrating()) {
+            ReleaseOldBuffer();
+        }
+    }
+
+    void ReleaseOldBuffer() noexcept {
+        ArrayPtr<Type> temp;
+        old_array_.swap(temp);
+        migrated_ = 0;
+        old_size_ = 0;
+    }
+
+    ArrayPtr<Type> array_;
+    ArrayPtr<Type> old_array_;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t migrated_ = 0;
+    size_t old_size_ = 0;
+    size_t migration_step_ = 8;
+};
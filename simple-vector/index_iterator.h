@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Итератор произвольного доступа, хранящий контейнер и индекс элемента.
+// Для контейнеров, чьи элементы не лежат одним непрерывным куском
+// (кольцевой буфер, вектор во время переноса): разыменование идёт через operator[] контейнера
+template <typename Container, typename Value>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+    using Owner = std::conditional_t<std::is_const_v<Value>, const Container, Container>;
+
+    IndexIterator() noexcept = default;
+
+    IndexIterator(Owner* owner, size_t index) noexcept
+        :owner_(owner), index_(index)
+    {
+
+    }
+
+    // Неконстантный итератор неявно преобразуется в константный
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value> && !std::is_const_v<Other>>>
+    IndexIterator(const IndexIterator<Container, Other>& other) noexcept
+        :owner_(other.owner_), index_(other.index_)
+    {
+
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    pointer operator->() const noexcept {
+        return &(*owner_)[index_];
+    }
+
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept {
+        IndexIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    IndexIterator operator--(int) noexcept {
+        IndexIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    IndexIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    IndexIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator+(difference_type offset, IndexIterator it) noexcept {
+        return it += offset;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+    // Возвращает индекс элемента в контейнере
+    size_t GetIndex() const noexcept {
+        return index_;
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
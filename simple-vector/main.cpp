@@ -2,6 +2,9 @@
 //
 //// Tests
 #include "tests.h"
+#ifdef SIMPLE_VECTOR_BENCHMARKS
+#include "benchmarks.h"
+#endif
 //
 //int main() {
 //    Test1();
@@ -133,15 +136,15 @@ void TestNoncopiableInsert() {
         v.PushBack(X(i));
     }
 
-    //  
+    // в начало
     v.Insert(v.begin(), X(size + 1));
     assert(v.GetSize() == size + 1);
     assert(v.begin()->GetX() == size + 1);
-    //  
+    // в конец
     v.Insert(v.end(), X(size + 2));
     assert(v.GetSize() == size + 2);
     assert((v.end() - 1)->GetX() == size + 2);
-    //  
+    // в середину
     v.Insert(v.begin() + 3, X(size + 3));
     assert(v.GetSize() == size + 3);
     assert((v.begin() + 3)->GetX() == size + 3);
@@ -174,5 +177,23 @@ int main() {
     Test2();
     TestReserveConstructor();
     TestReserveMethod();
+    TestIterators();
+#ifdef SIMPLE_VECTOR_DEATH_TESTS
+    TestCheckedIteratorTraps();
+#endif
+    TestMemoryUsage();
+    TestIncrementalVector();
+    TestFlatSet();
+    TestFlatMap();
+    TestSimpleDeque();
+    TestPackedVector();
+    TestStaticSimpleVector();
+    TestRangeViews();
+    TestVectorExpressions();
+    TestStreamingLoader();
+    TestBufferPool();
+#ifdef SIMPLE_VECTOR_BENCHMARKS
+    RunBenchmarks();
+#endif
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+// Объём динамической памяти, принадлежащей объекту
+struct MemoryUsageInfo {
+    size_t used_bytes = 0;      // занято элементами
+    size_t reserved_bytes = 0;  // выделено всего
+
+    // Возвращает выделенную, но не занятую элементами память
+    size_t GetSlack() const noexcept {
+        return reserved_bytes - used_bytes;
+    }
+
+    MemoryUsageInfo& operator+=(const MemoryUsageInfo& other) noexcept {
+        used_bytes += other.used_bytes;
+        reserved_bytes += other.reserved_bytes;
+        return *this;
+    }
+};
+
+template <typename T, typename = void>
+struct HasMemoryUsage : std::false_type {};
+
+// Тип сам сообщает о своей памяти через метод MemoryUsage() (например, вложенный SimpleVector)
+template <typename T>
+struct HasMemoryUsage<T, std::void_t<decltype(std::declval<const T&>().MemoryUsage())>> : std::true_type {};
+
+// Возвращает динамическую память, которой владеет value, не считая sizeof(value).
+// Для собственных типов достаточно метода MemoryUsage() или перегрузки HeapMemoryUsage,
+// найденной через ADL
+template <typename T>
+MemoryUsageInfo HeapMemoryUsage(const T& value) {
+    if constexpr (HasMemoryUsage<T>::value) {
+        return value.MemoryUsage();
+    }
+    else {
+        return {};
+    }
+}
+
+// Строка, поместившаяся во внутренний буфер (SSO), динамической памяти не занимает
+template <typename Char, typename Traits, typename Allocator>
+MemoryUsageInfo HeapMemoryUsage(const std::basic_string<Char, Traits, Allocator>& str) {
+    const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+    const auto* object = reinterpret_cast<const unsigned char*>(&str);
+    const std::less<const unsigned char*> less;
+    if (!less(data, object) && less(data, object + sizeof(str))) {
+        return {};
+    }
+    return { (str.size() + 1) * sizeof(Char), (str.capacity() + 1) * sizeof(Char) };
+}
+
+// Сводка по всем живым векторам SimpleVector<Type> одного типа элементов
+struct TypeMemoryStats {
+    std::string type_name;
+    size_t used_bytes = 0;
+    size_t reserved_bytes = 0;
+
+    size_t GetSlack() const noexcept {
+        return reserved_bytes - used_bytes;
+    }
+};
+
+// Счётчики собственных буферов SimpleVector<Type>, без памяти, которой владеют элементы:
+// вложенные SimpleVector учитываются под своим типом
+struct TypeMemoryCounters {
+    explicit TypeMemoryCounters(const char* name)
+        :type_name(name)
+    {
+
+    }
+
+    void Add(std::ptrdiff_t used_delta, std::ptrdiff_t reserved_delta) noexcept {
+        used_bytes.fetch_add(used_delta, std::memory_order_relaxed);
+        reserved_bytes.fetch_add(reserved_delta, std::memory_order_relaxed);
+    }
+
+    const char* type_name;
+    std::atomic<std::ptrdiff_t> used_bytes{ 0 };
+    std::atomic<std::ptrdiff_t> reserved_bytes{ 0 };
+};
+
+// Глобальный реестр памяти по инстанциациям SimpleVector.
+// Заполняется, только если определён макрос SIMPLE_VECTOR_MEMORY_REGISTRY
+class MemoryRegistry {
+public:
+    // Реестр намеренно не разрушается: векторы со статическим временем жизни
+    // могут обращаться к нему при завершении программы
+    static MemoryRegistry& Instance() {
+        static MemoryRegistry* instance = new MemoryRegistry;
+        return *instance;
+    }
+
+    template <typename Type>
+    static TypeMemoryCounters& CountersFor() {
+        static TypeMemoryCounters& counters = Instance().Register(typeid(Type).name());
+        return counters;
+    }
+
+    // Возвращает текущие значения счётчиков всех зарегистрированных типов
+    std::vector<TypeMemoryStats> Snapshot() const {
+        std::lock_guard guard(mutex_);
+        std::vector<TypeMemoryStats> result;
+        result.reserve(counters_.size());
+        for (const auto& counters : counters_) {
+            result.push_back({ counters->type_name,
+                static_cast<size_t>(counters->used_bytes.load(std::memory_order_relaxed)),
+                static_cast<size_t>(counters->reserved_bytes.load(std::memory_order_relaxed)) });
+        }
+        return result;
+    }
+
+private:
+    MemoryRegistry() = default;
+
+    TypeMemoryCounters& Register(const char* type_name) {
+        std::lock_guard guard(mutex_);
+        counters_.push_back(std::make_unique<TypeMemoryCounters>(type_name));
+        return *counters_.back();
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<TypeMemoryCounters>> counters_;
+};
@@ -0,0 +1,333 @@
+#pragma once
+#include "memory_usage.h"
+#include "simple_vector.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Операции над массивом 64-битных слов как над потоком битов.
+// Значение шириной width начинается с бита bit_position и может заходить в следующее слово,
+// поэтому за последним занятым словом массива всегда держится одно слово-заглушка
+class BitPacking {
+public:
+    // Возвращает наименьшее число бит, достаточное для value
+    static unsigned BitWidth(uint64_t value) noexcept {
+        unsigned width = 0;
+        while (value != 0) {
+            ++width;
+            value >>= 1;
+        }
+        return width;
+    }
+
+    static uint64_t Mask(unsigned width) noexcept {
+        return width == 0 ? 0 : ~uint64_t{ 0 } >> (64 - width);
+    }
+
+    static uint64_t Read(const uint64_t* words, size_t bit_position, uint64_t mask) noexcept {
+        const size_t word = bit_position / 64;
+        const unsigned offset = bit_position % 64;
+        // Двойной сдвиг вместо << (64 - offset) не даёт сдвига на 64 при offset == 0
+        const uint64_t value = (words[word] >> offset) | ((words[word + 1] << 1) << (63 - offset));
+        return value & mask;
+    }
+
+    // Записывает value в обнулённые биты
+    static void Write(uint64_t* words, size_t bit_position, uint64_t value) noexcept {
+        const size_t word = bit_position / 64;
+        const unsigned offset = bit_position % 64;
+        words[word] |= value << offset;
+        words[word + 1] |= (value >> 1) >> (63 - offset);
+    }
+
+    // Распаковывает count значений подряд. Цикл без ветвлений по данным,
+    // компилятор может векторизовать его при оптимизации
+    template <typename UInt>
+    static void Unpack(const uint64_t* words, size_t bit_position, unsigned width, size_t count, UInt* out) noexcept {
+        const uint64_t mask = Mask(width);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<UInt>(Read(words, bit_position + i * width, mask));
+        }
+    }
+
+    // Возвращает количество слов для count значений шириной width, включая нулевое слово-заглушку
+    static size_t WordsFor(size_t count, unsigned width) noexcept {
+        return count * width / 64 + 2;
+    }
+};
+
+// Вектор беззнаковых целых, хранящий каждое значение в bit_width битах.
+// Ширина подбирается по данным: если новое значение в неё не помещается, вектор
+// перепаковывается с большей шириной (не более 64 раз за время жизни).
+// operator[] - O(1), последовательный обход - блоками через ForEach или Decode
+template <typename UInt>
+class PackedSimpleVector {
+    static_assert(std::is_unsigned_v<UInt> && sizeof(UInt) <= sizeof(uint64_t), "UInt must be an unsigned integer up to 64 bits");
+
+public:
+    PackedSimpleVector() = default;
+
+    // Создаёт пустой вектор с заранее выбранной шириной значений
+    explicit PackedSimpleVector(unsigned bit_width)
+        :bit_width_(std::min(bit_width, static_cast<unsigned>(std::numeric_limits<UInt>::digits))),
+        mask_(BitPacking::Mask(bit_width_))
+    {
+
+    }
+
+    // Упаковывает values с шириной, достаточной для наибольшего значения
+    static PackedSimpleVector FromSimpleVector(const SimpleVector<UInt>& values) {
+        const UInt max_value = values.IsEmpty() ? 0 : *std::max_element(values.begin(), values.end());
+        PackedSimpleVector result(BitPacking::BitWidth(max_value));
+        result.Reserve(values.GetSize());
+        for (const UInt value : values) {
+            result.PushBack(value);
+        }
+        return result;
+    }
+
+    SimpleVector<UInt> ToSimpleVector() const {
+        SimpleVector<UInt> result(size_);
+        if (size_ > 0) {
+            Decode(0, size_, &result[0]);
+        }
+        return result;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    unsigned GetBitWidth() const noexcept {
+        return bit_width_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        words_.Reserve(BitPacking::WordsFor(new_capacity, bit_width_));
+    }
+
+    void Clear() noexcept {
+        words_.Clear();
+        size_ = 0;
+    }
+
+    void PushBack(UInt value) {
+        if (value > mask_) {
+            Repack(BitPacking::BitWidth(value));
+        }
+        const size_t words_needed = BitPacking::WordsFor(size_ + 1, bit_width_);
+        while (words_.GetSize() < words_needed) {
+            words_.PushBack(0);
+        }
+        BitPacking::Write(&words_[0], size_ * bit_width_, value);
+        ++size_;
+    }
+
+    UInt operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        if (bit_width_ == 0) {
+            return 0;
+        }
+        return static_cast<UInt>(BitPacking::Read(&words_[0], index * bit_width_, mask_));
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    UInt At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return (*this)[index];
+    }
+
+    // Распаковывает count значений, начиная с first, в out
+    void Decode(size_t first, size_t count, UInt* out) const noexcept {
+        SIMPLE_VECTOR_CHECK(first + count <= size_, "decoded range is out of range");
+        if (bit_width_ == 0 || count == 0) {
+            std::fill(out, out + count, UInt{ 0 });
+            return;
+        }
+        BitPacking::Unpack(&words_[0], first * bit_width_, bit_width_, count, out);
+    }
+
+    // Вызывает func для каждого значения по порядку, распаковывая их блоками
+    template <typename Func>
+    void ForEach(Func func) const {
+        UInt block[kDecodeBlockSize];
+        for (size_t first = 0; first < size_; first += kDecodeBlockSize) {
+            const size_t count = std::min(kDecodeBlockSize, size_ - first);
+            Decode(first, count, block);
+            for (size_t i = 0; i < count; ++i) {
+                func(block[i]);
+            }
+        }
+    }
+
+    MemoryUsageInfo MemoryUsage() const {
+        return words_.MemoryUsage();
+    }
+
+private:
+    static constexpr size_t kDecodeBlockSize = 256;
+
+    void Repack(unsigned new_width) {
+        PackedSimpleVector result(new_width);
+        result.Reserve(size_);
+        ForEach([&result](UInt value) {
+            result.PushBack(value);
+        });
+        *this = std::move(result);
+    }
+
+    SimpleVector<uint64_t> words_;
+    size_t size_ = 0;
+    unsigned bit_width_ = 0;
+    uint64_t mask_ = 0;
+};
+
+// Вектор неубывающих беззнаковых целых (например, отсортированных идентификаторов),
+// сжатый блоками по kBlockSize значений: первое значение блока хранится целиком,
+// остальные - как разности с предыдущим шириной, достаточной для наибольшей разности блока.
+// Незаполненный последний блок хранится несжатым. operator[] распаковывает префикс одного блока
+template <typename UInt>
+class DeltaPackedSimpleVector {
+    static_assert(std::is_unsigned_v<UInt> && sizeof(UInt) <= sizeof(uint64_t), "UInt must be an unsigned integer up to 64 bits");
+
+public:
+    static constexpr size_t kBlockSize = 128;
+
+    DeltaPackedSimpleVector() = default;
+
+    // Выбрасывает исключение std::invalid_argument, если values не упорядочен по неубыванию
+    static DeltaPackedSimpleVector FromSimpleVector(const SimpleVector<UInt>& values) {
+        DeltaPackedSimpleVector result;
+        for (const UInt value : values) {
+            result.PushBack(value);
+        }
+        return result;
+    }
+
+    SimpleVector<UInt> ToSimpleVector() const {
+        SimpleVector<UInt> result;
+        result.Reserve(GetSize());
+        ForEach([&result](UInt value) {
+            result.PushBack(value);
+        });
+        return result;
+    }
+
+    size_t GetSize() const noexcept {
+        return blocks_.GetSize() * kBlockSize + tail_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    void Clear() noexcept {
+        blocks_.Clear();
+        words_.Clear();
+        tail_.Clear();
+        last_ = 0;
+    }
+
+    // Выбрасывает исключение std::invalid_argument, если value меньше последнего значения
+    void PushBack(UInt value) {
+        if (!IsEmpty() && value < last_) {
+            throw std::invalid_argument("Values must be non-decreasing!"s);
+        }
+        tail_.PushBack(value);
+        last_ = value;
+        if (tail_.GetSize() == kBlockSize) {
+            CompressTail();
+        }
+    }
+
+    UInt operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < GetSize(), "index is out of range");
+        const size_t block_index = index / kBlockSize;
+        const size_t offset = index % kBlockSize;
+        if (block_index == blocks_.GetSize()) {
+            return tail_[offset];
+        }
+        const Block& block = blocks_[block_index];
+        UInt value = block.first;
+        const uint64_t mask = BitPacking::Mask(block.width);
+        for (size_t i = 0; i < offset; ++i) {
+            value += static_cast<UInt>(BitPacking::Read(&words_[0], block.bit_position + i * block.width, mask));
+        }
+        return value;
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    UInt At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return (*this)[index];
+    }
+
+    // Вызывает func для каждого значения по порядку, распаковывая блок целиком
+    template <typename Func>
+    void ForEach(Func func) const {
+        UInt deltas[kBlockSize];
+        for (const Block& block : blocks_) {
+            BitPacking::Unpack(&words_[0], block.bit_position, block.width, kBlockSize - 1, deltas);
+            UInt value = block.first;
+            func(value);
+            for (size_t i = 0; i + 1 < kBlockSize; ++i) {
+                value += deltas[i];
+                func(value);
+            }
+        }
+        for (const UInt value : tail_) {
+            func(value);
+        }
+    }
+
+    MemoryUsageInfo MemoryUsage() const {
+        MemoryUsageInfo usage = blocks_.MemoryUsage();
+        usage += words_.MemoryUsage();
+        usage += tail_.MemoryUsage();
+        return usage;
+    }
+
+private:
+    struct Block {
+        UInt first = 0;
+        unsigned width = 0;
+        size_t bit_position = 0;
+    };
+
+    void CompressTail() {
+        UInt max_delta = 0;
+        for (size_t i = 1; i < kBlockSize; ++i) {
+            max_delta = std::max(max_delta, static_cast<UInt>(tail_[i] - tail_[i - 1]));
+        }
+        Block block;
+        block.first = tail_[0];
+        block.width = BitPacking::BitWidth(max_delta);
+        block.bit_position = words_.IsEmpty() ? 0 : (words_.GetSize() - 1) * 64;
+
+        const size_t words_needed = block.bit_position / 64 + BitPacking::WordsFor(kBlockSize - 1, block.width);
+        while (words_.GetSize() < words_needed) {
+            words_.PushBack(0);
+        }
+        for (size_t i = 1; i < kBlockSize; ++i) {
+            BitPacking::Write(&words_[0], block.bit_position + (i - 1) * block.width, tail_[i] - tail_[i - 1]);
+        }
+        blocks_.PushBack(block);
+        tail_.Clear();
+    }
+
+    SimpleVector<Block> blocks_;
+    SimpleVector<uint64_t> words_;
+    SimpleVector<UInt> tail_;
+    UInt last_ = 0;
+};
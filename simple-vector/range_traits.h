@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+// Свойства произвольных диапазонов (контейнеров и ленивых представлений),
+// нужные для построения SimpleVector за одно выделение памяти
+
+template <typename Range>
+using RangeIterator = decltype(std::begin(std::declval<Range&>()));
+
+// Тип элемента диапазона: std::decay от результата разыменования итератора
+template <typename Range>
+using RangeValue = std::decay_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+template <typename T, typename = void>
+struct HasRangeSize : std::false_type {};
+
+// Размер диапазона известен без обхода: std::size вызывает метод size()
+template <typename T>
+struct HasRangeSize<T, std::void_t<decltype(std::size(std::declval<T&>()))>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasRangeMaxSize : std::false_type {};
+
+// Представление знает верхнюю границу своего размера (например, фильтр - размер исходного диапазона)
+template <typename T>
+struct HasRangeMaxSize<T, std::void_t<decltype(std::declval<T&>().MaxSize())>> : std::true_type {};
+
+template <typename T, typename = void>
+struct IsForwardRange : std::false_type {};
+
+// Прямой диапазон с одинаковыми типами начала и конца: его можно обойти повторно через std::distance
+template <typename T>
+struct IsForwardRange<T, std::void_t<RangeIterator<T>, typename std::iterator_traits<RangeIterator<T>>::iterator_category>>
+    : std::conjunction<
+        std::is_same<RangeIterator<T>, decltype(std::end(std::declval<T&>()))>,
+        std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<RangeIterator<T>>::iterator_category>> {};
+
+// Возвращает точный размер диапазона, если он известен, иначе - верхнюю границу размера.
+// Прямой диапазон без размера обходится один раз для подсчёта, однопроходный даёт 0
+template <typename Range>
+constexpr size_t RangeSizeHint(Range& range) {
+    if constexpr (HasRangeSize<Range>::value) {
+        return static_cast<size_t>(std::size(range));
+    }
+    else if constexpr (HasRangeMaxSize<Range>::value) {
+        return static_cast<size_t>(range.MaxSize());
+    }
+    else if constexpr (IsForwardRange<Range>::value) {
+        return static_cast<size_t>(std::distance(std::begin(range), std::end(range)));
+    }
+#if __cplusplus >= 202002L
+    // Итераторы std::views::transform объявлены однопроходными для старых алгоритмов,
+    // но модель std::ranges::forward_range разрешает повторный обход
+    else if constexpr (std::ranges::forward_range<Range>) {
+        return static_cast<size_t>(std::ranges::distance(range));
+    }
+#endif
+    else {
+        return 0;
+    }
+}
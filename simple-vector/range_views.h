@@ -0,0 +1,280 @@
+#pragma once
+#include "range_traits.h"
+#include "simple_vector.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Ленивые представления над диапазонами и их сборка в SimpleVector.
+// Конвейер v | Filter(pred) | Transform(func) | Collect() не создаёт промежуточных векторов:
+// элементы вычисляются при обходе, а Collect() выделяет память результата один раз.
+// Представление ссылается на исходный lvalue-диапазон и должно жить не дольше него;
+// временный диапазон (rvalue) перемещается внутрь представления
+
+// Ссылка на lvalue-диапазон, которую можно хранить внутри представления
+template <typename Range>
+class RefView {
+public:
+    explicit RefView(Range& range) noexcept
+        :range_(&range)
+    {
+
+    }
+
+    auto begin() const {
+        return std::begin(*range_);
+    }
+
+    auto end() const {
+        return std::end(*range_);
+    }
+
+    template <typename R = Range, typename = std::enable_if_t<HasRangeSize<R>::value>>
+    size_t size() const {
+        return static_cast<size_t>(std::size(*range_));
+    }
+
+private:
+    Range* range_;
+};
+
+// Диапазон, хранимый представлением: lvalue - по ссылке, rvalue - по значению
+template <typename Range>
+using ViewOf = std::conditional_t<std::is_lvalue_reference_v<Range>,
+    RefView<std::remove_reference_t<Range>>, std::decay_t<Range>>;
+
+template <typename Range>
+ViewOf<Range> MakeView(Range&& range) {
+    if constexpr (std::is_lvalue_reference_v<Range>) {
+        return ViewOf<Range>(range);
+    }
+    else {
+        return std::move(range);
+    }
+}
+
+// Представление, применяющее func к каждому элементу Base при разыменовании.
+// Размер известен, если известен размер Base
+template <typename Base, typename Func>
+class TransformView {
+    using BaseIterator = RangeIterator<const Base>;
+
+public:
+    // operator* возвращает значение, а не ссылку, поэтому для старых алгоритмов итератор однопроходный.
+    // В C++20 iterator_concept разрешает повторный обход, как у std::views::transform
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+#if __cplusplus >= 202002L
+        using iterator_concept = std::forward_iterator_tag;
+#endif
+        using value_type = std::decay_t<std::invoke_result_t<const Func&, decltype(*std::declval<BaseIterator>())>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator() = default;
+
+        Iterator(BaseIterator it, const Func* func)
+            :it_(it), func_(func)
+        {
+
+        }
+
+        reference operator*() const {
+            return std::invoke(*func_, *it_);
+        }
+
+        Iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++it_;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+            return lhs.it_ == rhs.it_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        BaseIterator it_{};
+        const Func* func_ = nullptr;
+    };
+
+    TransformView(Base base, Func func)
+        :base_(std::move(base)), func_(std::move(func))
+    {
+
+    }
+
+    Iterator begin() const {
+        return Iterator(std::begin(base_), &func_);
+    }
+
+    Iterator end() const {
+        return Iterator(std::end(base_), &func_);
+    }
+
+    template <typename B = Base, typename = std::enable_if_t<HasRangeSize<const B>::value>>
+    size_t size() const {
+        return static_cast<size_t>(std::size(base_));
+    }
+
+    // Верхняя граница размера для Base без точного размера (например, фильтра)
+    template <typename B = Base, typename = std::enable_if_t<HasRangeMaxSize<const B>::value>>
+    size_t MaxSize() const {
+        return base_.MaxSize();
+    }
+
+private:
+    Base base_;
+    Func func_;
+};
+
+// Представление, пропускающее элементы Base, для которых pred возвращает false.
+// Точный размер неизвестен без обхода, MaxSize() - размер Base
+template <typename Base, typename Pred>
+class FilterView {
+    using BaseIterator = RangeIterator<const Base>;
+
+public:
+    // Над представлением, возвращающим значения (например, TransformView), итератор тоже однопроходный
+    class Iterator {
+    public:
+        using value_type = RangeValue<const Base>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = decltype(*std::declval<BaseIterator>());
+        using iterator_category = std::conditional_t<std::is_reference_v<reference>,
+            std::forward_iterator_tag, std::input_iterator_tag>;
+#if __cplusplus >= 202002L
+        using iterator_concept = std::forward_iterator_tag;
+#endif
+
+        Iterator() = default;
+
+        Iterator(BaseIterator it, BaseIterator last, const Pred* pred)
+            :it_(it), last_(last), pred_(pred)
+        {
+            SkipRejected();
+        }
+
+        reference operator*() const {
+            return *it_;
+        }
+
+        Iterator& operator++() {
+            ++it_;
+            SkipRejected();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+            return lhs.it_ == rhs.it_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        void SkipRejected() {
+            while (it_ != last_ && !std::invoke(*pred_, *it_)) {
+                ++it_;
+            }
+        }
+
+        BaseIterator it_{};
+        BaseIterator last_{};
+        const Pred* pred_ = nullptr;
+    };
+
+    FilterView(Base base, Pred pred)
+        :base_(std::move(base)), pred_(std::move(pred))
+    {
+
+    }
+
+    Iterator begin() const {
+        return Iterator(std::begin(base_), std::end(base_), &pred_);
+    }
+
+    Iterator end() const {
+        return Iterator(std::end(base_), std::end(base_), &pred_);
+    }
+
+    size_t MaxSize() const {
+        return RangeSizeHint(base_);
+    }
+
+private:
+    Base base_;
+    Pred pred_;
+};
+
+template <typename Func>
+struct TransformAdaptor {
+    Func func;
+};
+
+template <typename Pred>
+struct FilterAdaptor {
+    Pred pred;
+};
+
+struct CollectAdaptor {
+};
+
+// Возвращает адаптор для range | Transform(func)
+template <typename Func>
+TransformAdaptor<std::decay_t<Func>> Transform(Func&& func) {
+    return { std::forward<Func>(func) };
+}
+
+// Возвращает адаптор для range | Filter(pred)
+template <typename Pred>
+FilterAdaptor<std::decay_t<Pred>> Filter(Pred&& pred) {
+    return { std::forward<Pred>(pred) };
+}
+
+// Возвращает адаптор для range | Collect()
+inline CollectAdaptor Collect() {
+    return {};
+}
+
+// Собирает элементы диапазона в SimpleVector за одно выделение памяти
+template <typename Range>
+SimpleVector<RangeValue<Range>> Collect(Range&& range) {
+    return SimpleVector<RangeValue<Range>>(from_range, std::forward<Range>(range));
+}
+
+template <typename Range, typename Func>
+TransformView<ViewOf<Range>, Func> operator|(Range&& range, TransformAdaptor<Func> adaptor) {
+    return { MakeView(std::forward<Range>(range)), std::move(adaptor.func) };
+}
+
+template <typename Range, typename Pred>
+FilterView<ViewOf<Range>, Pred> operator|(Range&& range, FilterAdaptor<Pred> adaptor) {
+    return { MakeView(std::forward<Range>(range)), std::move(adaptor.pred) };
+}
+
+template <typename Range>
+SimpleVector<RangeValue<Range>> operator|(Range&& range, CollectAdaptor) {
+    return Collect(std::forward<Range>(range));
+}
@@ -0,0 +1,253 @@
+#pragma once
+#include "array_ptr.h"
+#include "checked_iterator.h"
+#include "index_iterator.h"
+#include "memory_usage.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace std::literals;
+
+// Двусторонняя очередь на кольцевом буфере ArrayPtr.
+// Вставка и удаление с обоих концов - амортизированное O(1): элементы не сдвигаются,
+// меняется только индекс начала head_. Логический элемент i лежит в ячейке (head_ + i) % capacity_.
+// При переполнении буфер удваивается, а элементы переносятся в начало нового буфера по порядку
+template <typename Type>
+class SimpleDeque {
+public:
+    using Iterator = IndexIterator<SimpleDeque, Type>;
+    using ConstIterator = IndexIterator<SimpleDeque, const Type>;
+
+    SimpleDeque() noexcept = default;
+
+    SimpleDeque(const SimpleDeque& other)
+        :array_(other.size_), capacity_(other.size_), size_(other.size_)
+    {
+        std::copy(other.begin(), other.end(), array_.Get());
+    }
+
+    SimpleDeque(SimpleDeque&& other) noexcept {
+        swap(other);
+    }
+
+    SimpleDeque(std::initializer_list<Type> init)
+        :array_(init.size()), capacity_(init.size()), size_(init.size())
+    {
+        std::copy(init.begin(), init.end(), array_.Get());
+    }
+
+    SimpleDeque& operator=(const SimpleDeque& rhs) {
+        if (this != &rhs) {
+            SimpleDeque temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SimpleDeque& operator=(SimpleDeque&& rhs) noexcept {
+        if (this != &rhs) {
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // Возвращает количество элементов в очереди
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость кольцевого буфера
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushBack(const Type& value) {
+        GrowIfFull();
+        array_[Physical(size_)] = value;
+        ++size_;
+    }
+
+    void PushBack(Type&& value) {
+        GrowIfFull();
+        array_[Physical(size_)] = std::move(value);
+        ++size_;
+    }
+
+    void PushFront(const Type& value) {
+        GrowIfFull();
+        head_ = head_ == 0 ? capacity_ - 1 : head_ - 1;
+        array_[head_] = value;
+        ++size_;
+    }
+
+    void PushFront(Type&& value) {
+        GrowIfFull();
+        head_ = head_ == 0 ? capacity_ - 1 : head_ - 1;
+        array_[head_] = std::move(value);
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "PopBack on empty deque");
+        --size_;
+    }
+
+    void PopFront() noexcept {
+        PopFrontN(1);
+    }
+
+    // Удаляет count первых элементов за O(1)
+    void PopFrontN(size_t count) noexcept {
+        SIMPLE_VECTOR_CHECK(count <= size_, "PopFrontN count is out of range");
+        if (count == size_) {
+            Clear();
+            return;
+        }
+        head_ = Physical(count);
+        size_ -= count;
+    }
+
+    Type& Front() noexcept {
+        return (*this)[0];
+    }
+
+    const Type& Front() const noexcept {
+        return (*this)[0];
+    }
+
+    Type& Back() noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    const Type& Back() const noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    // Возвращает ссылку на элемент с индексом index, считая от начала очереди
+    Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return array_[Physical(index)];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return array_[Physical(index)];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return array_[Physical(index)];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return array_[Physical(index)];
+    }
+
+    // Обнуляет размер очереди, не изменяя её вместимость
+    void Clear() noexcept {
+        size_ = 0;
+        head_ = 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    void swap(SimpleDeque& other) noexcept {
+        array_.swap(other.array_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    MemoryUsageInfo MemoryUsage() const {
+        MemoryUsageInfo usage{ size_ * sizeof(Type), capacity_ * sizeof(Type) };
+        if constexpr (!std::is_trivially_copyable_v<Type>) {
+            for (const Type& value : *this) {
+                usage += HeapMemoryUsage(value);
+            }
+        }
+        return usage;
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+private:
+    // Переводит логический индекс в индекс ячейки буфера; index < capacity_
+    size_t Physical(size_t index) const noexcept {
+        const size_t position = head_ + index;
+        return position >= capacity_ ? position - capacity_ : position;
+    }
+
+    void GrowIfFull() {
+        if (size_ == capacity_) {
+            Reallocate(std::max(static_cast<size_t>(1u), 2 * capacity_));
+        }
+    }
+
+    // Переносит элементы по порядку в начало нового буфера, "разворачивая" кольцо
+    void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type> temp(new_capacity);
+        const size_t first_part = std::min(size_, capacity_ - head_);
+        auto out = std::move(array_.Get() + head_, array_.Get() + head_ + first_part, temp.Get());
+        std::move(array_.Get(), array_.Get() + (size_ - first_part), out);
+        array_.swap(temp);
+        capacity_ = new_capacity;
+        head_ = 0;
+    }
+
+    ArrayPtr<Type> array_;
+    size_t capacity_ = 0;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+bool operator==(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type>
+bool operator!=(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return !(lhs == rhs);
+}
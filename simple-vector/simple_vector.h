@@ -1,10 +1,14 @@
 #pragma once
 
 #include "array_ptr.h"
+#include "checked_iterator.h"
+#include "memory_usage.h"
+#include "range_traits.h"
 #include <cassert>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -14,7 +18,7 @@ using namespace std::literals;
 
 class ReserveProxyObj {
 public:
-    explicit ReserveProxyObj(size_t capacity_to_reserve)
+    constexpr explicit ReserveProxyObj(size_t capacity_to_reserve)
         :capacity_(capacity_to_reserve)
     {
 
@@ -22,51 +26,66 @@ public:
     size_t capacity_ = 0;
 };
 
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+constexpr ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
+// Тег конструктора SimpleVector из произвольного диапазона, аналог std::from_range из C++23
+struct FromRangeTag {
+    explicit FromRangeTag() = default;
+};
+
+inline constexpr FromRangeTag from_range{};
+
 template <typename Type>
 class SimpleVector {
 public:
+#ifdef SIMPLE_VECTOR_CHECKED_ITERATORS
+    // Проверяемый режим: итераторы контролируют границы и инвалидацию
+    using Iterator = CheckedIterator<SimpleVector, Type>;
+    using ConstIterator = CheckedIterator<SimpleVector, const Type>;
+#else
     using Iterator = Type*;
     using ConstIterator = const Type*;
+#endif
+    using value_type = Type;
 
     SimpleVector() noexcept = default;
 
-    SimpleVector(const SimpleVector& other)
-        :size_(other.size_), capacity_(other.size_), array_(other.size_)
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+        :size_(other.size_), capacity_(other.size_), array_(ArrayPtr<Type>::Allocate(other.size_))
     {
-        std::copy(other.begin(), other.end(), begin());
+        std::copy(other.RawBegin(), other.RawEnd(), RawBegin());
+        AccountMemory(size_, capacity_);
     }
 
-    SimpleVector(SimpleVector&& other)
-        :size_(other.size_), capacity_(other.size_), array_(other.size_)
+    // Забирает буфер other, оставляя его пустым
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
     {
         swap(other);
-        other.Clear(); //test TestNamedMoveConstructor() checks if vector is empty
     }
 
-    SimpleVector(const ReserveProxyObj& input)
-        :capacity_(input.capacity_)
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const ReserveProxyObj& input)
     {
-        Reserve(capacity_);
+        Reserve(input.capacity_);
     }
 
-    //    size ,    
-    explicit SimpleVector(size_t size)
-        :capacity_(size), size_(size), array_(size)
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size)
+        :capacity_(size), size_(size), array_(ArrayPtr<Type>::Allocate(size))
     {
-        for (auto it = begin(); it != end(); ++it) {
+        for (auto it = RawBegin(); it != RawEnd(); ++it) {
             *it = Type();
         }
+        AccountMemory(size_, capacity_);
     }
 
-    //    size ,   value
-    SimpleVector(size_t size, const Type& value)
-        :capacity_(size), size_(size), array_(size)
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value)
+        :capacity_(size), size_(size), array_(ArrayPtr<Type>::Allocate(size))
     {
-        std::fill(begin(), end(), value);
+        std::fill(RawBegin(), RawEnd(), value);
+        AccountMemory(size_, capacity_);
     }
 
     //SimpleVector(size_t size, Type&& value)
@@ -77,14 +96,30 @@ public:
     //    }
     //}
 
-    //    std::initializer_list
-    SimpleVector(std::initializer_list<Type> init)
-        :size_(init.size()), capacity_(init.size()), array_(init.size())
+    // Создаёт вектор из std::initializer_list
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init)
+        :size_(init.size()), capacity_(init.size()), array_(ArrayPtr<Type>::Allocate(init.size()))
+    {
+        std::copy(init.begin(), init.end(), RawBegin());
+        AccountMemory(size_, capacity_);
+    }
+
+    // Создаёт вектор из элементов диапазона range (контейнера или ленивого представления).
+    // Память выделяется один раз: под точный размер, если он известен, иначе под верхнюю границу
+    // размера (RangeSizeHint); только однопроходный диапазон без размера растёт через PushBack
+    template <typename Range>
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(FromRangeTag, Range&& range)
     {
-        std::copy(init.begin(), init.end(), begin());
+        AppendWithHint(range, RangeSizeHint(range));
+    }
+
+    // Возвращает буфер в пул буферов потока, если он подключён
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        AccountMemory(-static_cast<std::ptrdiff_t>(size_), -static_cast<std::ptrdiff_t>(capacity_));
+        array_.Recycle(capacity_);
     }
 
-    SimpleVector operator=(const SimpleVector& rhs) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (this == &rhs) {
             return *this;
         }
@@ -93,7 +128,7 @@ public:
         return *this;
     }
 
-    SimpleVector operator=(SimpleVector&& rhs) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept {
         if (this != &rhs)
         {
             swap(rhs);
@@ -102,157 +137,189 @@ public:
         return *this;
     }
 
-    //     
-    size_t GetSize() const noexcept {
+    // Возвращает количество элементов в массиве
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
         return size_;
     }
 
-    void PushBack(const Type& value) {
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& value) {
+        MemoryAccountingScope accounting(*this);
         if (capacity_ == 0) {
-            Reserve(1);
+            Reallocate(1);
         }
         else if (size_ >= capacity_) {
-            Reserve(2 * capacity_);
+            Reallocate(2 * capacity_);
         }
         (*this).array_[size_] = value;
         ++size_;
     }
 
-    void PushBack(Type&& value) {
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& value) {
+        MemoryAccountingScope accounting(*this);
         if (capacity_ == 0) {
-            Reserve(1);
+            Reallocate(1);
         }
         else if (size_ >= capacity_) {
-            Reserve(2 * capacity_);
+            Reallocate(2 * capacity_);
         }
         (*this).array_[size_] = std::move(value);
         ++size_;
     }
 
-    void PopBack() noexcept {
-        assert(size_ > 0);
+    // Добавляет в конец элементы диапазона range. Если размер range известен, память
+    // выделяется не более одного раза; после Reserve под итоговый размер - ни разу
+    template <typename Range>
+    SIMPLE_VECTOR_CONSTEXPR void AppendRange(Range&& range) {
+        AppendWithHint(range, RangeSizeHint(range));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "PopBack on empty vector");
+        MemoryAccountingScope accounting(*this);
             --size_;
     }
 
-    Iterator Erase(ConstIterator pos) {
-        assert(pos >= cbegin() && pos < cend());
-        auto p = const_cast<Iterator>(pos);
-        std::move(p + 1, end(), p);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        auto p = ToPointer(pos);
+        SIMPLE_VECTOR_CHECK(p < RawEnd(), "Erase position is out of range");
+        MemoryAccountingScope accounting(*this);
+        std::move(p + 1, RawEnd(), p);
         --size_;
-        return p;
+        Invalidate();
+        return MakeIterator(p);
     }
 
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(pos >= cbegin() && pos <= cend());
-        auto p = const_cast<Iterator>(pos);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        auto p = ToPointer(pos);
+        MemoryAccountingScope accounting(*this);
+        Invalidate();
         if (size_ < capacity_) {
-            std::copy_backward(p, end(), end() + 1);
+            std::copy_backward(p, RawEnd(), RawEnd() + 1);
             (*p) = value;
             ++size_;
-            return p;
+            return MakeIterator(p);
         }
         else {
-                SimpleVector<Type> temp(std::max(static_cast<size_t>(1u), 2 * size_));
-                auto s = temp.begin();
-                if (p != begin()) {
-                    s = std::copy(begin(), p, temp.begin());
-                }
+                const size_t new_capacity = std::max(static_cast<size_t>(1u), 2 * size_);
+                ArrayPtr<Type> temp = ArrayPtr<Type>::Allocate(new_capacity);
+                auto s = std::copy(RawBegin(), p, temp.Get());
                 *s = value;
-                std::copy(p, end(), s + 1);
-                array_.swap(temp.array_);
-                capacity_ = 2 * std::max(static_cast<size_t>(1u), 2 * size_);
+                std::copy(p, RawEnd(), s + 1);
+                array_.swap(temp);
+                temp.Recycle(capacity_);
+                capacity_ = new_capacity;
                 ++size_;
-                return s;
+                return MakeIterator(s);
         }
     }
 
-    Iterator Insert(ConstIterator pos, Type&& value) {
-        assert(pos >= cbegin() && pos <= cend());
-        auto p = const_cast<Iterator>(pos);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        auto p = ToPointer(pos);
+        MemoryAccountingScope accounting(*this);
+        Invalidate();
         if (size_ < capacity_) {
-            std::move_backward(p, end(), end() + 1);
+            std::move_backward(p, RawEnd(), RawEnd() + 1);
             *p = std::move(value);
             ++size_;
-            return p;
+            return MakeIterator(p);
         }
         else {
-                SimpleVector<Type> temp;
-                temp.Reserve(std::max(static_cast<size_t>(1u), 2 * size_));
-                auto s = temp.begin();
-                if (p != begin()) {
-                    s = std::move(begin(), p, temp.begin());
-                }
+                const size_t new_capacity = std::max(static_cast<size_t>(1u), 2 * size_);
+                ArrayPtr<Type> temp = ArrayPtr<Type>::Allocate(new_capacity);
+                auto s = std::move(RawBegin(), p, temp.Get());
                 *s = std::move(value);
-                std::move(p, end(), s + 1);
-                array_.swap(temp.array_);
-                capacity_ = 2 * std::max(static_cast<size_t>(1u), 2 * size_);
+                std::move(p, RawEnd(), s + 1);
+                array_.swap(temp);
+                temp.Recycle(capacity_);
+                capacity_ = new_capacity;
                 ++size_;
-                return s;
+                return MakeIterator(s);
         }
     }
 
-    void swap(SimpleVector& other) noexcept {
+    // Итераторы обоих векторов инвалидируются: в проверяемом режиме итератор привязан к владельцу
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         array_.swap(other.array_);
         std::swap(capacity_, other.capacity_);
         std::swap(size_, other.size_);
+        Invalidate();
+        other.Invalidate();
+    }
+
+    // Возвращает указатель на первый элемент; вместе с size() делает вектор
+    // непрерывным диапазоном с известным размером (std::ranges::contiguous_range, sized_range)
+    SIMPLE_VECTOR_CONSTEXPR Type* data() noexcept {
+        return RawBegin();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* data() const noexcept {
+        return RawBegin();
     }
 
-    //   
-    size_t GetCapacity() const noexcept {
+    // То же, что GetSize(), под именем, которое ожидают std::size и std::ranges::size
+    SIMPLE_VECTOR_CONSTEXPR size_t size() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
         return capacity_;
     }
 
-    // ,   
-    bool IsEmpty() const noexcept {
+    // Сообщает, пустой ли массив
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
-    //       index
-    Type& operator[](size_t index) noexcept {
-        assert(index < size_);
+    // Возвращает ссылку на элемент с индексом index
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
         return array_[index];
     }
 
-    //        index
-    const Type& operator[](size_t index) const noexcept {
-        assert(index < size_);
+    // Возвращает константную ссылку на элемент с индексом index
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
         return array_[index];
     }
 
-    //        index
-    //   std::out_of_range,  index >= size
-    Type& At(size_t index) {
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Index is out of range!"s);
         }
         return array_[index];
     }
 
-    //        index
-    //   std::out_of_range,  index >= size
-    const Type& At(size_t index) const {
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("Index is out of range!"s);
         }
         return array_[index];
     }
 
-    //   ,    
-    void Clear() noexcept {
+    // Обнуляет размер массива, не изменяя его вместимость
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        MemoryAccountingScope accounting(*this);
         size_ = 0;
+        Invalidate();
     }
 
-    //   .
-    //            Type
-    void Resize(size_t new_size) {
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        MemoryAccountingScope accounting(*this);
         if (new_size < size_) {
             size_ = new_size;
         }
         else {
             if (new_size > capacity_) {
-                Reserve(new_size);
+                Reallocate(new_size);
             }
-            for (auto it = begin() + size_; it < begin() + capacity_; ++it) {
+            for (auto it = RawBegin() + size_; it < RawBegin() + capacity_; ++it) {
                 *it = Type();
             }
             size_ = new_size;
@@ -260,82 +327,239 @@ public:
 
     }
 
-    void Reserve(size_t new_capacity) {
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
         if (new_capacity > capacity_) {
-                ArrayPtr<Type> temp(new_capacity);
-                std::move(begin(), end(), temp.Get());
-                temp.swap(array_);
-                capacity_ = new_capacity;
+                MemoryAccountingScope accounting(*this);
+                Reallocate(new_capacity);
         }
     }
 
-    //     
-    //       (  ) nullptr
-    Iterator begin() noexcept {
-        return array_.Get();
+    // Отдаёт буфер в пул буферов потока (или освобождает его), оставляя вектор пустым с нулевой вместимостью.
+    // Позволяет вернуть память в пул раньше разрушения вектора
+    SIMPLE_VECTOR_CONSTEXPR void Recycle() noexcept {
+        MemoryAccountingScope accounting(*this);
+        array_.Recycle(capacity_);
+        size_ = 0;
+        capacity_ = 0;
+        Invalidate();
     }
 
-    //    ,   
-    //       (  ) nullptr
-    Iterator end() noexcept {
-        return array_.Get() + size_;
+    // Уменьшает вместимость до размера вектора, освобождая неиспользуемую память
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (size_ < capacity_) {
+            MemoryAccountingScope accounting(*this);
+            Reallocate(size_);
+        }
     }
 
-    //      
-    //       (  ) nullptr
-    ConstIterator begin() const noexcept {
-        return array_.Get();
+    // Возвращает память в куче, занятую буфером вектора и, рекурсивно, его элементами
+    MemoryUsageInfo MemoryUsage() const {
+        MemoryUsageInfo usage{ size_ * sizeof(Type), capacity_ * sizeof(Type) };
+        if constexpr (!std::is_trivially_copyable_v<Type>) {
+            for (auto it = RawBegin(); it != RawEnd(); ++it) {
+                usage += HeapMemoryUsage(*it);
+            }
+        }
+        return usage;
     }
 
-    //    ,   
-    //       (  ) nullptr
-    ConstIterator end() const noexcept {
-        return array_.Get() + size_;
+    // Возвращает итератор на начало массива
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
+        return MakeIterator(RawBegin());
     }
 
-    //      
-    //       (  ) nullptr
-    ConstIterator cbegin() const noexcept {
+    // Возвращает итератор на элемент, следующий за последним
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
+        return MakeIterator(RawEnd());
+    }
+
+    // Возвращает константный итератор на начало массива
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
+        return MakeIterator(RawBegin());
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
+        return MakeIterator(RawEnd());
+    }
+
+    // Возвращает константный итератор на начало массива
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
+        return MakeIterator(RawBegin());
+    }
+
+    // Возвращает итератор на элемент, следующий за последним
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
+        return MakeIterator(RawEnd());
+    }
+private:
+#ifdef SIMPLE_VECTOR_CHECKED_ITERATORS
+    friend Iterator;
+    friend ConstIterator;
+#endif
+
+#ifdef SIMPLE_VECTOR_MEMORY_REGISTRY
+    // Переносит в MemoryRegistry изменения размера и вместимости, сделанные за время своей жизни
+    class MemoryAccountingScope {
+    public:
+        SIMPLE_VECTOR_CONSTEXPR explicit MemoryAccountingScope(const SimpleVector& vector) noexcept
+            :vector_(vector), size_(vector.size_), capacity_(vector.capacity_)
+        {
+
+        }
+
+        SIMPLE_VECTOR_CONSTEXPR ~MemoryAccountingScope() {
+            vector_.AccountMemory(static_cast<std::ptrdiff_t>(vector_.size_ - size_),
+                static_cast<std::ptrdiff_t>(vector_.capacity_ - capacity_));
+        }
+
+    private:
+        const SimpleVector& vector_;
+        size_t size_;
+        size_t capacity_;
+    };
+
+    SIMPLE_VECTOR_CONSTEXPR void AccountMemory(std::ptrdiff_t size_delta, std::ptrdiff_t capacity_delta) const noexcept {
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+        // Векторы, созданные при компиляции, в реестр не попадают
+        if (std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        MemoryRegistry::CountersFor<Type>().Add(size_delta * static_cast<std::ptrdiff_t>(sizeof(Type)),
+            capacity_delta * static_cast<std::ptrdiff_t>(sizeof(Type)));
+    }
+#else
+    class MemoryAccountingScope {
+    public:
+        SIMPLE_VECTOR_CONSTEXPR explicit MemoryAccountingScope(const SimpleVector&) noexcept {
+        }
+    };
+
+    SIMPLE_VECTOR_CONSTEXPR void AccountMemory(std::ptrdiff_t, std::ptrdiff_t) const noexcept {
+    }
+#endif
+
+    // Дописывает элементы range, заранее выделив место под size_hint элементов.
+    // Вместимость растёт не менее чем вдвое, чтобы серия добавлений оставалась амортизированно линейной
+    template <typename Range>
+    SIMPLE_VECTOR_CONSTEXPR void AppendWithHint(Range& range, size_t size_hint) {
+        if (size_ + size_hint > capacity_) {
+            Reserve(std::max(size_ + size_hint, 2 * capacity_));
+        }
+        if constexpr (HasRangeSize<Range>::value) {
+            MemoryAccountingScope accounting(*this);
+            Type* out = RawEnd();
+            for (auto&& value : range) {
+                *out++ = std::forward<decltype(value)>(value);
+            }
+            size_ = static_cast<size_t>(out - RawBegin());
+            SIMPLE_VECTOR_CHECK(size_ <= capacity_, "range is longer than its size()");
+        }
+        else {
+            for (auto&& value : range) {
+                PushBack(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
+    // Переносит элементы в новый буфер вместимостью new_capacity >= size_
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type> temp = ArrayPtr<Type>::Allocate(new_capacity);
+        std::move(RawBegin(), RawEnd(), temp.Get());
+        temp.swap(array_);
+        temp.Recycle(capacity_);
+        capacity_ = new_capacity;
+        Invalidate();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type* RawBegin() const noexcept {
         return array_.Get();
     }
 
-    //    ,   
-    //       (  ) nullptr
-    ConstIterator cend() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* RawEnd() const noexcept {
         return array_.Get() + size_;
     }
-private:
+
+#ifdef SIMPLE_VECTOR_CHECKED_ITERATORS
+    SIMPLE_VECTOR_CONSTEXPR Iterator MakeIterator(Type* ptr) noexcept {
+        return Iterator(this, ptr);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator MakeIterator(const Type* ptr) const noexcept {
+        return ConstIterator(this, ptr);
+    }
+
+    // Проверяет, что pos - действительный итератор этого вектора в диапазоне [begin, end]
+    SIMPLE_VECTOR_CONSTEXPR Type* ToPointer(ConstIterator pos) const {
+        SIMPLE_VECTOR_CHECK(pos.owner_ == this, "iterator belongs to another container");
+        pos.CheckValid();
+        SIMPLE_VECTOR_CHECK(pos.ptr_ >= RawBegin() && pos.ptr_ <= RawEnd(), "iterator is out of range");
+        return const_cast<Type*>(pos.ptr_);
+    }
+
+    // Делает недействительными все ранее выданные итераторы
+    SIMPLE_VECTOR_CONSTEXPR void Invalidate() noexcept {
+        ++generation_;
+    }
+#else
+    SIMPLE_VECTOR_CONSTEXPR Iterator MakeIterator(Type* ptr) noexcept {
+        return ptr;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator MakeIterator(const Type* ptr) const noexcept {
+        return ptr;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type* ToPointer(ConstIterator pos) const noexcept {
+        SIMPLE_VECTOR_CHECK(pos >= RawBegin() && pos <= RawEnd(), "iterator is out of range");
+        return const_cast<Type*>(pos);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Invalidate() noexcept {
+    }
+#endif
+
     size_t capacity_ = 0;
     size_t size_ = 0;
     ArrayPtr<Type> array_;
+#ifdef SIMPLE_VECTOR_CHECKED_ITERATORS
+    size_t generation_ = 0;
+#endif
 };
 
 template <typename Type>
-bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
 template <typename Type>
-bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return !(lhs == rhs);
 }
 
 template <typename Type>
-bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 template <typename Type>
-bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return !(rhs < lhs);
 }
 
 template <typename Type>
-bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return rhs < lhs;
 }
 
 template <typename Type>
-bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
     return rhs <= lhs;
 }
\ No newline at end of file
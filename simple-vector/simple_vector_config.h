@@ -0,0 +1,11 @@
+#pragma once
+
+// ArrayPtr и SimpleVector пригодны для constexpr-вычислений, если компилятор
+// поддерживает выделение памяти в constexpr-функциях (C++20)
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc)
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#else
+#define SIMPLE_VECTOR_CONSTEXPR
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 0
+#endif
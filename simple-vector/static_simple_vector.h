@@ -0,0 +1,237 @@
+#pragma once
+#include "checked_iterator.h"
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std::literals;
+
+// Вектор фиксированной вместимости N без динамической памяти с интерфейсом SimpleVector.
+// Все операции constexpr, поэтому таблицы, построенные при компиляции, попадают
+// в секцию констант (.rodata) и не требуют работы при запуске программы.
+// Для тривиально копируемого Type сам вектор тривиально копируем.
+// Превышение вместимости выбрасывает std::length_error
+template <typename Type, size_t N>
+class StaticSimpleVector {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    constexpr StaticSimpleVector() = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    constexpr explicit StaticSimpleVector(size_t size)
+        :StaticSimpleVector(size, Type())
+    {
+
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    constexpr StaticSimpleVector(size_t size, const Type& value) {
+        CheckCapacity(size);
+        for (size_t i = 0; i < size; ++i) {
+            data_[i] = value;
+        }
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    constexpr StaticSimpleVector(std::initializer_list<Type> init) {
+        CheckCapacity(init.size());
+        for (const Type& value : init) {
+            data_[size_++] = value;
+        }
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость, всегда равную N
+    constexpr size_t GetCapacity() const noexcept {
+        return N;
+    }
+
+    constexpr bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr void PushBack(const Type& value) {
+        CheckCapacity(size_ + 1);
+        data_[size_++] = value;
+    }
+
+    constexpr void PushBack(Type&& value) {
+        CheckCapacity(size_ + 1);
+        data_[size_++] = std::move(value);
+    }
+
+    constexpr void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "PopBack on empty vector");
+        --size_;
+    }
+
+    constexpr Iterator Insert(ConstIterator pos, const Type& value) {
+        Type copy = value;
+        return Insert(pos, std::move(copy));
+    }
+
+    constexpr Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = static_cast<size_t>(pos - data_);
+        SIMPLE_VECTOR_CHECK(index <= size_, "iterator is out of range");
+        CheckCapacity(size_ + 1);
+        for (size_t i = size_; i > index; --i) {
+            data_[i] = std::move(data_[i - 1]);
+        }
+        data_[index] = std::move(value);
+        ++size_;
+        return data_ + index;
+    }
+
+    constexpr Iterator Erase(ConstIterator pos) {
+        const size_t index = static_cast<size_t>(pos - data_);
+        SIMPLE_VECTOR_CHECK(index < size_, "Erase position is out of range");
+        for (size_t i = index; i + 1 < size_; ++i) {
+            data_[i] = std::move(data_[i + 1]);
+        }
+        --size_;
+        return data_ + index;
+    }
+
+    constexpr void Clear() noexcept {
+        size_ = 0;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    constexpr void Resize(size_t new_size) {
+        CheckCapacity(new_size);
+        for (size_t i = size_; i < new_size; ++i) {
+            data_[i] = Type();
+        }
+        size_ = new_size;
+    }
+
+    constexpr Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return data_[index];
+    }
+
+    constexpr const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index is out of range");
+        return data_[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return data_[index];
+    }
+
+    constexpr const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out of range!"s);
+        }
+        return data_[index];
+    }
+
+    constexpr void swap(StaticSimpleVector& other) noexcept {
+        const size_t common = size_ < other.size_ ? size_ : other.size_;
+        for (size_t i = 0; i < common; ++i) {
+            Type temp = std::move(data_[i]);
+            data_[i] = std::move(other.data_[i]);
+            other.data_[i] = std::move(temp);
+        }
+        for (size_t i = common; i < other.size_; ++i) {
+            data_[i] = std::move(other.data_[i]);
+        }
+        for (size_t i = common; i < size_; ++i) {
+            other.data_[i] = std::move(data_[i]);
+        }
+        std::swap(size_, other.size_);
+    }
+
+    constexpr Iterator begin() noexcept {
+        return data_;
+    }
+
+    constexpr Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    constexpr void CheckCapacity(size_t size) const {
+        if (size > N) {
+            throw std::length_error("StaticSimpleVector capacity exceeded!"s);
+        }
+    }
+
+    Type data_[N > 0 ? N : 1]{};
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t N>
+constexpr bool operator==(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.GetSize(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator!=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    for (size_t i = 0; i < lhs.GetSize() && i < rhs.GetSize(); ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.GetSize() < rhs.GetSize();
+}
+
+template <typename Type, size_t N>
+constexpr bool operator<=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+constexpr bool operator>=(const StaticSimpleVector<Type, N>& lhs, const StaticSimpleVector<Type, N>& rhs) {
+    return rhs <= lhs;
+}
@@ -0,0 +1,395 @@
+#pragma once
+#include "simple_deque.h"
+#include "simple_vector.h"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Потоковая загрузка чисел в SimpleVector из файлов и каналов.
+// Текст читается крупными блоками в отдельном потоке, блоки разбираются std::from_chars
+// в потоках-обработчиках, а вызывающий поток дописывает разобранные пакеты в результат
+// строго по порядку блоков через AppendRange. Чтение и разбор идут одновременно;
+// число блоков "в работе" ограничено, поэтому память не растёт с размером файла
+
+// Состояние загрузки, передаваемое в обратный вызов после каждого пакета
+struct LoadProgress {
+    size_t bytes_read = 0;
+    size_t elements_loaded = 0;
+};
+
+struct StreamingLoadOptions {
+    // Размер блока чтения в байтах
+    size_t chunk_size = 1 << 20;
+    // Число потоков разбора; 0 - по числу ядер
+    size_t worker_count = 0;
+    // Ожидаемое число элементов: вектор резервируется заранее и не перевыделяется
+    size_t size_hint = 0;
+    // Вызывается в потоке, вызвавшем загрузку, после добавления каждого пакета
+    std::function<void(const LoadProgress&)> on_progress;
+};
+
+inline bool IsNumberSeparator(char c) noexcept {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Разбирает числа, разделённые пробельными символами, из [first, last) и дописывает их в out.
+// Выбрасывает исключение std::invalid_argument, если встретилось не число
+template <typename Number>
+void ParseNumbers(const char* first, const char* last, SimpleVector<Number>& out) {
+    while (true) {
+        while (first != last && IsNumberSeparator(*first)) {
+            ++first;
+        }
+        if (first == last) {
+            return;
+        }
+        // from_chars не принимает ведущий '+', его допускает только чтение из потока.
+        // Знак пропускается, только если за ним начинается число без знака: "+-5" - ошибка
+        if (*first == '+') {
+            const bool unsigned_number_follows = last - first > 1
+                && ((first[1] >= '0' && first[1] <= '9') || (std::is_floating_point_v<Number> && first[1] == '.'));
+            if (!unsigned_number_follows) {
+                const char* token_end = std::find_if(first, last, IsNumberSeparator);
+                throw std::invalid_argument("Invalid number: "s + std::string(first, std::min(token_end, first + 32)));
+            }
+            ++first;
+        }
+        Number value{};
+        const auto [end, error] = std::from_chars(first, last, value);
+        if (error != std::errc() || (end != last && !IsNumberSeparator(*end))) {
+            const char* token_end = std::find_if(first, last, IsNumberSeparator);
+            throw std::invalid_argument("Invalid number: "s + std::string(first, std::min(token_end, first + 32)));
+        }
+        out.PushBack(value);
+        first = end;
+    }
+}
+
+// Конвейер загрузки текста: поток чтения -> потоки разбора -> вызывающий поток
+template <typename Number>
+class TextLoadPipeline {
+public:
+    TextLoadPipeline(std::FILE* stream, const StreamingLoadOptions& options)
+        :stream_(stream),
+        options_(options),
+        worker_count_(options.worker_count > 0 ? options.worker_count
+            : std::max(1u, std::thread::hardware_concurrency())),
+        window_(2 * worker_count_ + 2),
+        slots_(window_)
+    {
+        options_.chunk_size = std::max<size_t>(options_.chunk_size, 1);
+        spare_texts_.Reserve(window_);
+    }
+
+    SimpleVector<Number> Run() {
+        SimpleVector<Number> result(Reserve(options_.size_hint));
+        std::thread reader([this] {
+            ReadChunks();
+        });
+        SimpleVector<std::thread> workers;
+        workers.Reserve(worker_count_);
+        for (size_t i = 0; i < worker_count_; ++i) {
+            workers.PushBack(std::thread([this] {
+                ParseChunks();
+            }));
+        }
+
+        try {
+            AppendInOrder(result);
+        }
+        catch (...) {
+            Fail(std::current_exception());
+        }
+        Stop();
+        reader.join();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return result;
+    }
+
+private:
+    // Запас буфера под число, перенесённое из предыдущего блока, чтобы буфер подходил следующим блокам
+    static constexpr size_t kCarryReserve = 64;
+
+    struct Chunk {
+        size_t index = 0;
+        size_t bytes = 0;
+        SimpleVector<char> text;
+    };
+
+    struct Batch {
+        size_t bytes = 0;
+        SimpleVector<Number> values;
+    };
+
+    // Читает блоки; незаконченное число в конце блока переносится в начало следующего
+    void ReadChunks() {
+        try {
+            SimpleVector<char> carry;
+            for (size_t index = 0;; ++index) {
+                if (!WaitForFreeSlot()) {
+                    return;
+                }
+                Chunk chunk{ index, 0, TakeSpareText() };
+                const size_t chunk_bytes = carry.GetSize() + options_.chunk_size;
+                if (chunk.text.GetCapacity() < chunk_bytes) {
+                    // Прежнее содержимое не нужно: у пустого вектора перевыделение ничего не копирует
+                    chunk.text.Clear();
+                    chunk.text.Reserve(chunk_bytes + kCarryReserve);
+                }
+                chunk.text.Resize(chunk_bytes);
+                std::copy(carry.begin(), carry.end(), chunk.text.begin());
+                const size_t read = std::fread(chunk.text.data() + carry.GetSize(), 1, options_.chunk_size, stream_);
+                if (std::ferror(stream_)) {
+                    throw std::runtime_error("Failed to read input stream!"s);
+                }
+                chunk.bytes = read;
+                chunk.text.Resize(carry.GetSize() + read);
+                carry.Clear();
+                const bool at_end = read < options_.chunk_size;
+                if (!at_end) {
+                    size_t cut = chunk.text.GetSize();
+                    while (cut > 0 && !IsNumberSeparator(chunk.text[cut - 1])) {
+                        --cut;
+                    }
+                    for (size_t i = cut; i < chunk.text.GetSize(); ++i) {
+                        carry.PushBack(chunk.text[i]);
+                    }
+                    chunk.text.Resize(cut);
+                }
+                Submit(std::move(chunk));
+                if (at_end) {
+                    break;
+                }
+            }
+        }
+        catch (...) {
+            Fail(std::current_exception());
+        }
+        std::lock_guard guard(mutex_);
+        reading_done_ = true;
+        changed_.notify_all();
+    }
+
+    // Разбирает блоки из очереди, пока чтение не закончено и очередь не пуста
+    void ParseChunks() {
+        while (true) {
+            Chunk chunk;
+            {
+                std::unique_lock lock(mutex_);
+                changed_.wait(lock, [this] {
+                    return stopped_ || !pending_.IsEmpty() || reading_done_;
+                });
+                if (stopped_ || pending_.IsEmpty()) {
+                    return;
+                }
+                chunk = std::move(pending_.Front());
+                pending_.PopFront();
+            }
+            Batch batch;
+            batch.bytes = chunk.bytes;
+            try {
+                ParseNumbers(chunk.text.data(), chunk.text.data() + chunk.text.GetSize(), batch.values);
+            }
+            catch (...) {
+                Fail(std::current_exception());
+                return;
+            }
+            std::lock_guard guard(mutex_);
+            slots_[chunk.index % window_] = std::move(batch);
+            if (spare_texts_.GetSize() < spare_texts_.GetCapacity()) {
+                spare_texts_.PushBack(std::move(chunk.text));
+            }
+            changed_.notify_all();
+        }
+    }
+
+    // Дописывает пакеты в result в порядке блоков и сообщает о ходе загрузки
+    void AppendInOrder(SimpleVector<Number>& result) {
+        LoadProgress progress;
+        for (size_t index = 0;; ++index) {
+            Batch batch;
+            {
+                std::unique_lock lock(mutex_);
+                std::optional<Batch>& slot = slots_[index % window_];
+                changed_.wait(lock, [&] {
+                    return error_ || slot.has_value() || (reading_done_ && index == chunks_read_);
+                });
+                if (error_ || !slot.has_value()) {
+                    return;
+                }
+                batch = std::move(*slot);
+                slot.reset();
+                --in_flight_;
+                changed_.notify_all();
+            }
+            result.AppendRange(batch.values);
+            progress.bytes_read += batch.bytes;
+            progress.elements_loaded = result.GetSize();
+            if (options_.on_progress) {
+                options_.on_progress(progress);
+            }
+        }
+    }
+
+    // Ждёт, пока число блоков в работе не станет меньше окна. Возвращает false при остановке
+    bool WaitForFreeSlot() {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [this] {
+            return stopped_ || in_flight_ < window_;
+        });
+        return !stopped_;
+    }
+
+    // Возвращает буфер уже разобранного блока либо пустой вектор.
+    // Размер буфера не сбрасывается: Resize до размера блока заполняет нулями лишь короткий хвост,
+    // а не весь блок, как при выделении нового буфера
+    SimpleVector<char> TakeSpareText() {
+        std::lock_guard guard(mutex_);
+        if (spare_texts_.IsEmpty()) {
+            return {};
+        }
+        SimpleVector<char> text = std::move(spare_texts_[spare_texts_.GetSize() - 1]);
+        spare_texts_.PopBack();
+        return text;
+    }
+
+    void Submit(Chunk chunk) {
+        std::lock_guard guard(mutex_);
+        pending_.PushBack(std::move(chunk));
+        ++in_flight_;
+        ++chunks_read_;
+        changed_.notify_all();
+    }
+
+    void Fail(std::exception_ptr error) {
+        std::lock_guard guard(mutex_);
+        if (!error_) {
+            error_ = error;
+        }
+        stopped_ = true;
+        changed_.notify_all();
+    }
+
+    void Stop() {
+        std::lock_guard guard(mutex_);
+        stopped_ = true;
+        changed_.notify_all();
+    }
+
+    std::FILE* stream_;
+    StreamingLoadOptions options_;
+    size_t worker_count_;
+    // Наибольшее число прочитанных, но ещё не добавленных блоков
+    size_t window_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    SimpleDeque<Chunk> pending_;
+    // Разобранные пакеты; блок index ждёт своей очереди в ячейке index % window_
+    SimpleVector<std::optional<Batch>> slots_;
+    // Буферы разобранных блоков для повторного чтения; их не больше окна
+    SimpleVector<SimpleVector<char>> spare_texts_;
+    size_t in_flight_ = 0;
+    size_t chunks_read_ = 0;
+    bool reading_done_ = false;
+    bool stopped_ = false;
+    std::exception_ptr error_;
+};
+
+// Закрывает файл, открытый функциями загрузки
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept {
+        std::fclose(file);
+    }
+};
+
+// Выбрасывает исключение std::runtime_error, если файл не открылся
+inline std::unique_ptr<std::FILE, FileCloser> OpenForLoading(const std::filesystem::path& path) {
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.string().c_str(), "rb"));
+    if (!file) {
+        throw std::runtime_error("Failed to open "s + path.string());
+    }
+    return file;
+}
+
+// Загружает числа, разделённые пробельными символами, из потока (файла или канала) до его конца
+template <typename Number>
+SimpleVector<Number> LoadTextNumbers(std::FILE* stream, const StreamingLoadOptions& options = {}) {
+    return TextLoadPipeline<Number>(stream, options).Run();
+}
+
+template <typename Number>
+SimpleVector<Number> LoadTextNumbers(const std::filesystem::path& path, const StreamingLoadOptions& options = {}) {
+    const auto file = OpenForLoading(path);
+    return LoadTextNumbers<Number>(file.get(), options);
+}
+
+// Загружает массив Number в машинном представлении из потока до его конца.
+// Разбирать нечего, поэтому блоки читаются и дописываются в вызывающем потоке.
+// Выбрасывает исключение std::runtime_error, если длина данных не кратна sizeof(Number)
+template <typename Number>
+SimpleVector<Number> LoadBinaryNumbers(std::FILE* stream, const StreamingLoadOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<Number>, "Number must be trivially copyable");
+    SimpleVector<Number> result(Reserve(options.size_hint));
+    const size_t chunk_elements = std::max<size_t>(options.chunk_size / sizeof(Number), 1);
+    SimpleVector<Number> chunk(chunk_elements);
+    LoadProgress progress;
+    while (true) {
+        // fread возвращает меньше запрошенного только в конце данных
+        const size_t bytes = std::fread(chunk.data(), 1, chunk_elements * sizeof(Number), stream);
+        if (std::ferror(stream)) {
+            throw std::runtime_error("Failed to read input stream!"s);
+        }
+        if (bytes % sizeof(Number) != 0) {
+            throw std::runtime_error("Binary data size is not a multiple of the element size!"s);
+        }
+        if (bytes == 0) {
+            break;
+        }
+        chunk.Resize(bytes / sizeof(Number));
+        result.AppendRange(chunk);
+        progress.bytes_read += bytes;
+        progress.elements_loaded = result.GetSize();
+        if (options.on_progress) {
+            options.on_progress(progress);
+        }
+        if (chunk.GetSize() < chunk_elements) {
+            break;
+        }
+    }
+    return result;
+}
+
+// Если size_hint не задан, он вычисляется по размеру обычного файла.
+// У каналов (FIFO) размера нет, они читаются без подсказки
+template <typename Number>
+SimpleVector<Number> LoadBinaryNumbers(const std::filesystem::path& path, StreamingLoadOptions options = {}) {
+    std::error_code error;
+    if (options.size_hint == 0 && std::filesystem::is_regular_file(path, error)) {
+        const auto file_size = std::filesystem::file_size(path, error);
+        if (!error) {
+            options.size_hint = static_cast<size_t>(file_size / sizeof(Number));
+        }
+    }
+    const auto file = OpenForLoading(path);
+    return LoadBinaryNumbers<Number>(file.get(), options);
+}
@@ -1,10 +1,39 @@
 #pragma once
 #include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+#if defined(SIMPLE_VECTOR_CHECKED_ITERATORS) && (defined(__unix__) || defined(__APPLE__))
+#define SIMPLE_VECTOR_DEATH_TESTS
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+#include "buffer_pool.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "incremental_vector.h"
+#include "packed_vector.h"
+#include "range_views.h"
+#include "simple_deque.h"
 #include "simple_vector.h"
+#include "static_simple_vector.h"
+#include "streaming_loader.h"
+#include "vector_expressions.h"
 
 inline void Test1() {
-    //    
+    // Инициализация конструктором по умолчанию
     {
         SimpleVector<int> v;
         assert(v.GetSize() == 0u);
@@ -12,7 +41,7 @@ inline void Test1() {
         assert(v.GetCapacity() == 0u);
     }
 
-    //    
+    // Инициализация вектора указанного размера
     {
         SimpleVector<int> v(5);
         assert(v.GetSize() == 5u);
@@ -23,7 +52,7 @@ inline void Test1() {
         }
     }
 
-    //  ,   
+    // Инициализация вектора, заполненного заданным значением
     {
         SimpleVector<int> v(3, 42);
         assert(v.GetSize() == 3);
@@ -33,7 +62,7 @@ inline void Test1() {
         }
     }
 
-    //     initializer_list
+    // Инициализация вектора при помощи initializer_list
     {
         SimpleVector<int> v{ 1, 2, 3 };
         assert(v.GetSize() == 3);
@@ -41,22 +70,22 @@ inline void Test1() {
         assert(v[2] == 3);
     }
 
-    //      At
+    // Доступ к элементам при помощи At
     {
         SimpleVector<int> v(3);
         assert(&v.At(2) == &v[2]);
         try {
             v.At(3);
-            assert(false);  //   
+            assert(false);  // Ожидается выбрасывание исключения
         }
         catch (const std::out_of_range&) {
         }
         catch (...) {
-            assert(false);  //   ,   out_of_range
+            assert(false);  // Не ожидается исключение, отличное от out_of_range
         }
     }
 
-    //  
+    // Очистка вектора
     {
         SimpleVector<int> v(10);
         const size_t old_capacity = v.GetCapacity();
@@ -65,7 +94,7 @@ inline void Test1() {
         assert(v.GetCapacity() == old_capacity);
     }
 
-    //  
+    // Изменение размера
     {
         SimpleVector<int> v(3);
         v[2] = 17;
@@ -96,16 +125,16 @@ inline void Test1() {
         assert(v[3] == 0);
     }
 
-    //   SimpleVector
+    // Итерирование по SimpleVector
     {
-        //  
+        // Пустой вектор
         {
             SimpleVector<int> v;
             assert(v.begin() == nullptr);
             assert(v.end() == nullptr);
         }
 
-        //  
+        // Непустой вектор
         {
             SimpleVector<int> v(10, 42);
             assert(v.begin());
@@ -126,7 +155,7 @@ inline void Test2() {
         assert(v[1] == 42);
     }
 
-    //   , PushBack   Capacity
+    // Если хватает места, PushBack не увеличивает Capacity
     {
         SimpleVector<int> v(2);
         v.Resize(1);
@@ -147,7 +176,7 @@ inline void Test2() {
         assert((v == SimpleVector<int>{0, 1, 2}));
     }
 
-    //  
+    // Конструктор копирования
     {
         SimpleVector<int> numbers{ 1, 2 };
         auto numbers_copy(numbers);
@@ -159,7 +188,7 @@ inline void Test2() {
         }
     }
 
-    // 
+    // Сравнение
     {
         assert((SimpleVector{ 1, 2, 3 } == SimpleVector{ 1, 2, 3 }));
         assert((SimpleVector{ 1, 2, 3 } != SimpleVector{ 1, 2, 2 }));
@@ -173,7 +202,7 @@ inline void Test2() {
         assert((SimpleVector{ 1, 2, 3 } <= SimpleVector{ 1, 2, 4 }));
     }
 
-    //   
+    // Обмен значений векторов
     {
         SimpleVector<int> v1{ 42, 666 };
         SimpleVector<int> v2;
@@ -199,7 +228,7 @@ inline void Test2() {
         assert(v2.GetCapacity() == capacity1);
     }
 
-    // 
+    // Присваивание
     {
         SimpleVector<int> src_vector{ 1, 2, 3, 4 };
         SimpleVector<int> dst_vector{ 1, 2, 3, 4, 5, 6 };
@@ -207,7 +236,7 @@ inline void Test2() {
         assert(dst_vector == src_vector);
     }
 
-    //  
+    // Вставка элементов
 
     {
         SimpleVector<int> v;
@@ -248,7 +277,7 @@ inline void Test2() {
         assert((v == SimpleVector<int>{42,0,0,0,0}));
     }
 
-    //  
+    // Удаление элементов
     {
         SimpleVector<int> v{ 1, 2, 3, 4 };
         v.Erase(v.cbegin() + 2);
@@ -267,28 +296,834 @@ void TestReserveConstructor() {
 void TestReserveMethod() {
     std::cout << "TestReserveMethod"s << std::endl;
     SimpleVector<int> v;
-    //  5   
+    // зарезервируем 5 мест в векторе
     v.Reserve(5);
     assert(v.GetCapacity() == 5);
     assert(v.IsEmpty());
 
-    //   capacity  1
+    // попытаемся уменьшить capacity до 1
     v.Reserve(1);
-    // capacity   
+    // capacity должно остаться прежним
     assert(v.GetCapacity() == 5);
-    //  10   
+    // поместим 10 элементов в вектор
     for (int i = 0; i < 10; ++i) {
         v.PushBack(i);
     }
     assert(v.GetSize() == 10);
-    //  capacity  100
+    // увеличим capacity до 100
     v.Reserve(100);
-    // ,    
+    // проверим, что размер не поменялся
     assert(v.GetSize() == 10);
     assert(v.GetCapacity() == 100);
-    // ,    
+    // проверим, что элементы на месте
     for (int i = 0; i < 10; ++i) {
         assert(v[i] == i);
     }
     std::cout << "Done!"s << std::endl;
-}
\ No newline at end of file
+}
+void TestIterators() {
+    std::cout << "TestIterators"s << std::endl;
+    SimpleVector<int> v{ 5, 3, 1, 4, 2 };
+    std::sort(v.begin(), v.end());
+    assert((v == SimpleVector<int>{1, 2, 3, 4, 5}));
+
+    // Неконстантный итератор приводится к константному
+    SimpleVector<int>::ConstIterator it = v.begin() + 1;
+    assert(*it == 2);
+    assert(it[2] == 4);
+    assert(v.cend() - it == 4);
+    assert(it > v.cbegin() && it <= v.cend());
+    assert(*(v.end() - 1) == 5);
+    assert(std::find(v.cbegin(), v.cend(), 4) == v.cbegin() + 3);
+
+    // Итераторы, полученные после изменения вектора, действительны
+    auto pos = v.Insert(v.begin() + 2, 42);
+    assert(*pos == 42);
+    pos = v.Erase(pos);
+    assert(*pos == 3);
+    std::cout << "Done!"s << std::endl;
+}
+
+#ifdef SIMPLE_VECTOR_DEATH_TESTS
+// Выполняет func в дочернем процессе и проверяет, что тот завершился через SimpleVectorTrap
+// (abort) с диагностикой, содержащей expected_message.
+// Проверки сделаны через SIMPLE_VECTOR_CHECK, чтобы работать и в сборке с NDEBUG
+template <typename Func>
+void ExpectCheckFailure(const std::string& expected_message, Func func) {
+    int pipe_fds[2];
+    const int pipe_result = pipe(pipe_fds);
+    SIMPLE_VECTOR_CHECK(pipe_result == 0, "death test: pipe failed");
+    std::cout.flush();
+    std::fflush(stderr);
+    const pid_t pid = fork();
+    SIMPLE_VECTOR_CHECK(pid >= 0, "death test: fork failed");
+    if (pid == 0) {
+        close(pipe_fds[0]);
+        dup2(pipe_fds[1], STDERR_FILENO);
+        func();
+        _exit(0);
+    }
+    close(pipe_fds[1]);
+    std::string output;
+    char buffer[256];
+    ssize_t count = 0;
+    while ((count = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, static_cast<size_t>(count));
+    }
+    close(pipe_fds[0]);
+    int status = 0;
+    const pid_t waited = waitpid(pid, &status, 0);
+    SIMPLE_VECTOR_CHECK(waited == pid, "death test: waitpid failed");
+    SIMPLE_VECTOR_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT, "death test: expected check failure did not abort");
+    SIMPLE_VECTOR_CHECK(output.find(expected_message) != std::string::npos, "death test: unexpected diagnostic");
+}
+
+// Обращение через устаревший итератор и выход за границы должны завершать программу
+void TestCheckedIteratorTraps() {
+    std::cout << "TestCheckedIteratorTraps"s << std::endl;
+    const std::string invalidated = "iterator invalidated by Reserve, Insert, Erase, Clear or swap"s;
+    ExpectCheckFailure(invalidated, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        const auto it = v.begin();
+        v.Reserve(100);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure(invalidated, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        v.Reserve(10);
+        const auto it = v.begin();
+        v.Insert(v.begin(), 0);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure(invalidated, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        const auto it = v.begin();
+        v.Erase(v.begin() + 2);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure(invalidated, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        const auto it = v.begin();
+        v.Clear();
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure(invalidated, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        SimpleVector<int> other{ 4, 5 };
+        const auto it = v.begin();
+        v.swap(other);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure("dereferencing out-of-range iterator"s, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        static_cast<void>(*v.end());
+    });
+    ExpectCheckFailure("PopBack on empty vector"s, [] {
+        SimpleVector<int> v;
+        v.PopBack();
+    });
+    ExpectCheckFailure("index is out of range"s, [] {
+        SimpleVector<int> v{ 1, 2, 3 };
+        static_cast<void>(v[v.GetSize()]);
+    });
+    std::cout << "Done!"s << std::endl;
+}
+#endif
+
+void TestMemoryUsage() {
+    std::cout << "TestMemoryUsage"s << std::endl;
+    {
+        SimpleVector<int> v(Reserve(10));
+        v.PushBack(1);
+        v.PushBack(2);
+        const MemoryUsageInfo usage = v.MemoryUsage();
+        assert(usage.used_bytes == 2 * sizeof(int));
+        assert(usage.reserved_bytes == 10 * sizeof(int));
+        assert(usage.GetSlack() == 8 * sizeof(int));
+
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 2);
+        assert((v == SimpleVector<int>{1, 2}));
+        assert(v.MemoryUsage().GetSlack() == 0);
+    }
+    // Учитывается память вложенных векторов и строк, не поместившихся в SSO
+    {
+        SimpleVector<SimpleVector<int>> nested;
+        nested.PushBack(SimpleVector<int>(3));
+        nested.PushBack(SimpleVector<int>(Reserve(5)));
+        const MemoryUsageInfo usage = nested.MemoryUsage();
+        assert(usage.used_bytes == 2 * sizeof(SimpleVector<int>) + 3 * sizeof(int));
+        assert(usage.reserved_bytes == 2 * sizeof(SimpleVector<int>) + 8 * sizeof(int));
+
+        const std::string long_string(100, 'x');
+        SimpleVector<std::string> strings{ ""s, long_string };
+        assert(strings.MemoryUsage().used_bytes >= 2 * sizeof(std::string) + long_string.size());
+    }
+#ifdef SIMPLE_VECTOR_MEMORY_REGISTRY
+    {
+        auto find_stats = [] {
+            for (const TypeMemoryStats& stats : MemoryRegistry::Instance().Snapshot()) {
+                if (stats.type_name == typeid(double).name()) {
+                    return stats;
+                }
+            }
+            return TypeMemoryStats{};
+        };
+        const TypeMemoryStats before = find_stats();
+        {
+            SimpleVector<double> v(Reserve(4));
+            v.PushBack(1.0);
+            const TypeMemoryStats during = find_stats();
+            assert(during.used_bytes - before.used_bytes == sizeof(double));
+            assert(during.reserved_bytes - before.reserved_bytes == 4 * sizeof(double));
+        }
+        const TypeMemoryStats after = find_stats();
+        assert(after.used_bytes == before.used_bytes);
+        assert(after.reserved_bytes == before.reserved_bytes);
+    }
+#endif
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestIncrementalVector() {
+    std::cout << "TestIncrementalVector"s << std::endl;
+    IncrementalSimpleVector<int> v(1);
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(i);
+        // Во время переноса все элементы доступны по индексу и через итераторы
+        for (int j = 0; j <= i; ++j) {
+            assert(v[j] == j);
+        }
+        assert(std::distance(v.begin(), v.end()) == i + 1);
+        assert(std::is_sorted(v.cbegin(), v.cend()));
+    }
+    assert(v.GetSize() == 100);
+    assert(v.GetCapacity() == 128);
+
+    // Перенос ещё идёт: 64 элемента старого буфера переносятся по одному за PushBack
+    assert(v.IsMigrating());
+    v.PopBack();
+    assert(v.At(98) == 98);
+    v.FinishMigration();
+    assert(!v.IsMigrating());
+    for (int i = 0; i < 99; ++i) {
+        assert(v[i] == i);
+    }
+
+    // PopBack ниже границы перенесённых элементов завершает перенос
+    IncrementalSimpleVector<int> w(1);
+    for (int i = 0; i < 9; ++i) {
+        w.PushBack(i);
+    }
+    assert(w.IsMigrating());
+    while (w.GetSize() > 1) {
+        w.PopBack();
+    }
+    assert(!w.IsMigrating());
+    assert(w[0] == 0);
+    w.Clear();
+    assert(w.IsEmpty());
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestFlatSet() {
+    std::cout << "TestFlatSet"s << std::endl;
+    const SimpleVector<int> input{ 5, 1, 4, 1, 3, 5, 2 };
+    FlatSet<int> set(input.begin(), input.end());
+    assert((set.GetKeys() == SimpleVector<int>{1, 2, 3, 4, 5}));
+    assert(set.Contains(4));
+    assert(!set.Contains(6));
+    assert(*set.LowerBound(0) == 1);
+    assert(set.LowerBound(6) == set.end());
+    assert(set.Find(7) == set.end());
+
+    assert(set.Insert(0).second);
+    assert(!set.Insert(3).second);
+    assert(*set.Insert(10).first == 10);
+    assert(set.Erase(4) == 1);
+    assert(set.Erase(4) == 0);
+    assert((set.GetKeys() == SimpleVector<int>{0, 1, 2, 3, 5, 10}));
+
+    const SimpleVector<int> batch{ 7, 2, 6, 7, -1 };
+    set.InsertBatch(batch.begin(), batch.end());
+    assert((set.GetKeys() == SimpleVector<int>{-1, 0, 1, 2, 3, 5, 6, 7, 10}));
+
+    set.Merge(FlatSet<int>{ 100, 3 });
+    assert(set.GetSize() == 10);
+    const auto after_erased = set.Erase(set.Find(100));
+    assert(after_erased == set.end());
+    assert((set == FlatSet<int>{ 10, 7, 6, 5, 3, 2, 1, 0, -1 }));
+
+    FlatSet<int, std::greater<int>> descending{ 1, 3, 2 };
+    assert((descending.GetKeys() == SimpleVector<int>{3, 2, 1}));
+    std::cout << "Done!"s << std::endl;
+}
+
+// Значение, копирование и перемещение которого выбрасывают исключение, пока поднят флаг
+struct ThrowingAssignValue {
+    inline static bool fail = false;
+
+    ThrowingAssignValue() = default;
+
+    ThrowingAssignValue(int value)
+        :value(value)
+    {
+
+    }
+
+    ThrowingAssignValue(const ThrowingAssignValue& other)
+        :value(other.value)
+    {
+        ThrowIfFailing();
+    }
+
+    ThrowingAssignValue& operator=(const ThrowingAssignValue& other) {
+        ThrowIfFailing();
+        value = other.value;
+        return *this;
+    }
+
+    static void ThrowIfFailing() {
+        if (fail) {
+            throw std::runtime_error("Value assignment failed"s);
+        }
+    }
+
+    int value = 0;
+};
+
+void TestFlatMap() {
+    std::cout << "TestFlatMap"s << std::endl;
+    FlatMap<std::string, int> map{ { "b"s, 2 }, { "a"s, 1 }, { "c"s, 3 }, { "a"s, 100 } };
+    assert(map.GetSize() == 3);
+    assert((map.GetKeys() == SimpleVector<std::string>{"a"s, "b"s, "c"s}));
+    assert((map.GetValues() == SimpleVector<int>{1, 2, 3}));
+    assert(*map.Find("b"s) == 2);
+    assert(map.Find("z"s) == nullptr);
+    assert(map.LowerBound("bb"s) == 2);
+    try {
+        map.At("z"s);
+        assert(false);
+    }
+    catch (const std::out_of_range&) {
+    }
+
+    assert(map.Insert("d"s, 4).second);
+    assert(!map.Insert("a"s, -1).second);
+    assert(map.At("a"s) == 1);
+    map["e"s] = 5;
+    ++map["a"s];
+    assert(map.At("a"s) == 2);
+    assert(map.Erase("b"s) == 1);
+    assert(!map.Contains("b"s));
+
+    const SimpleVector<std::pair<std::string, int>> batch{ { "f"s, 6 }, { "a"s, -1 }, { "b"s, 20 }, { "f"s, 60 } };
+    map.InsertBatch(batch.begin(), batch.end());
+    assert((map.GetKeys() == SimpleVector<std::string>{"a"s, "b"s, "c"s, "d"s, "e"s, "f"s}));
+    assert((map.GetValues() == SimpleVector<int>{2, 20, 3, 4, 5, 6}));
+
+    FlatMap<std::string, int> other{ { "g"s, 7 }, { "c"s, 30 } };
+    map.Merge(other);
+    assert(map.GetSize() == 7);
+    assert(map.At("c"s) == 3);
+    assert(map.At("g"s) == 7);
+
+    // Исключение при вставке значения не оставляет в столбце ключей лишний ключ
+    {
+        FlatMap<int, ThrowingAssignValue> throwing{ { 1, 10 }, { 3, 30 } };
+        ThrowingAssignValue::fail = true;
+        try {
+            throwing.Insert(2, 20);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        ThrowingAssignValue::fail = false;
+        assert((throwing.GetKeys() == SimpleVector<int>{1, 3}));
+        assert(throwing.GetValues().GetSize() == 2);
+        assert(throwing.At(3).value == 30);
+    }
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestSimpleDeque() {
+    std::cout << "TestSimpleDeque"s << std::endl;
+    SimpleDeque<int> d;
+    for (int i = 0; i < 5; ++i) {
+        d.PushBack(i);
+    }
+    d.PopFrontN(3);
+    // Кольцо переходит через конец буфера: 3 4 5 6 7 лежат в ячейках 3 4 5 6 7 0 1 2
+    for (int i = 5; i < 10; ++i) {
+        d.PushBack(i);
+    }
+    assert(d.GetCapacity() == 8);
+    assert((d == SimpleDeque<int>{3, 4, 5, 6, 7, 8, 9}));
+    assert(d.end() - d.begin() == 7);
+    assert(*(d.begin() + 6) == 9);
+    assert(std::is_sorted(d.begin(), d.end()));
+
+    // Рост разворачивает кольцо
+    d.PushFront(2);
+    d.PushFront(1);
+    assert(d.GetCapacity() == 16);
+    assert((d == SimpleDeque<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    assert(d.Front() == 1 && d.Back() == 9);
+
+    d.PopFront();
+    d.PopBack();
+    assert((d == SimpleDeque<int>{2, 3, 4, 5, 6, 7, 8}));
+    assert(d.At(0) == 2);
+    try {
+        d.At(7);
+        assert(false);
+    }
+    catch (const std::out_of_range&) {
+    }
+
+    // PushFront в пустую очередь и некопируемые элементы
+    SimpleDeque<std::unique_ptr<int>> pointers;
+    pointers.PushFront(std::make_unique<int>(2));
+    pointers.PushFront(std::make_unique<int>(1));
+    pointers.PushBack(std::make_unique<int>(3));
+    assert(*pointers[0] == 1 && *pointers[1] == 2 && *pointers[2] == 3);
+    pointers.PopFrontN(3);
+    assert(pointers.IsEmpty());
+
+    SimpleDeque<int> copy(d);
+    d.Clear();
+    assert(d.IsEmpty());
+    assert(copy.GetSize() == 7);
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestPackedVector() {
+    std::cout << "TestPackedVector"s << std::endl;
+    {
+        PackedSimpleVector<uint32_t> v;
+        assert(v.GetBitWidth() == 0);
+        v.PushBack(0);
+        v.PushBack(0);
+        assert(v.GetBitWidth() == 0);
+        assert(v[1] == 0);
+        // Ширина растёт вместе с данными, ранее записанные значения сохраняются
+        for (uint32_t i = 0; i < 1000; ++i) {
+            v.PushBack(i * 7);
+        }
+        v.PushBack(std::numeric_limits<uint32_t>::max());
+        assert(v.GetBitWidth() == 32);
+        assert(v.GetSize() == 1003);
+        assert(v[0] == 0 && v[2] == 0);
+        for (uint32_t i = 0; i < 1000; ++i) {
+            assert(v[i + 2] == i * 7);
+        }
+        assert(v.At(1002) == std::numeric_limits<uint32_t>::max());
+    }
+    {
+        SimpleVector<uint64_t> values;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            values.PushBack((i * 2654435761u) % 1000);
+        }
+        const auto packed = PackedSimpleVector<uint64_t>::FromSimpleVector(values);
+        assert(packed.GetBitWidth() == 10);
+        assert(packed.ToSimpleVector() == values);
+        assert(packed.MemoryUsage().used_bytes < values.GetSize() * sizeof(uint64_t) / 6);
+
+        uint64_t sum = 0;
+        size_t index = 0;
+        packed.ForEach([&](uint64_t value) {
+            assert(value == values[index++]);
+            sum += value;
+        });
+        assert(index == values.GetSize());
+        assert(sum == std::accumulate(values.begin(), values.end(), uint64_t{ 0 }));
+    }
+    {
+        SimpleVector<uint32_t> ids;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            ids.PushBack(1'000'000 + i * 3 + (i % 5 == 0 ? 1 : 0) + (i > 500 ? 100'000 : 0));
+        }
+        const auto packed = DeltaPackedSimpleVector<uint32_t>::FromSimpleVector(ids);
+        assert(packed.GetSize() == ids.GetSize());
+        for (size_t i = 0; i < ids.GetSize(); ++i) {
+            assert(packed[i] == ids[i]);
+        }
+        assert(packed.ToSimpleVector() == ids);
+        assert(packed.MemoryUsage().used_bytes < ids.GetSize() * sizeof(uint32_t) / 2);
+
+        DeltaPackedSimpleVector<uint32_t> v;
+        v.PushBack(5);
+        try {
+            v.PushBack(4);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+    }
+    std::cout << "Done!"s << std::endl;
+}
+
+// Таблица квадратов, полностью вычисляемая при компиляции
+constexpr StaticSimpleVector<int, 16> MakeSquaresTable() {
+    StaticSimpleVector<int, 16> table;
+    for (int i = 0; i < 10; ++i) {
+        table.PushBack(i * i);
+    }
+    table.Insert(table.begin(), -1);
+    table.Erase(table.begin() + 5);
+    return table;
+}
+
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+// Возвращает сумму элементов SimpleVector, построенного и освобождённого при компиляции
+constexpr int SumOfConstexprSimpleVector() {
+    SimpleVector<int> v;
+    for (int i = 1; i <= 5; ++i) {
+        v.PushBack(i);
+    }
+    v.Insert(v.begin(), 10);
+    v.Erase(v.begin() + 1);
+    v.Resize(7);
+    SimpleVector<int> copy = v;
+    int sum = 0;
+    for (int value : copy) {
+        sum += value;
+    }
+    return sum + static_cast<int>(copy.GetSize());
+}
+#endif
+
+void TestStaticSimpleVector() {
+    std::cout << "TestStaticSimpleVector"s << std::endl;
+    {
+        constexpr auto table = MakeSquaresTable();
+        static_assert(table.GetSize() == 10);
+        static_assert(table.GetCapacity() == 16);
+        static_assert(table[0] == -1 && table[1] == 0 && table[4] == 9 && table[5] == 25);
+        static_assert(table == StaticSimpleVector<int, 16>{ -1, 0, 1, 4, 9, 25, 36, 49, 64, 81 });
+        static_assert(std::is_trivially_copyable_v<StaticSimpleVector<int, 16>>);
+        assert(table.At(9) == 81);
+    }
+#if SIMPLE_VECTOR_HAS_CONSTEXPR
+    static_assert(SumOfConstexprSimpleVector() == 10 + 2 + 3 + 4 + 5 + 7);
+#endif
+    {
+        StaticSimpleVector<std::string, 4> v(2, "x"s);
+        v.PushBack("y"s);
+        assert(v.GetSize() == 3 && v[2] == "y"s);
+        v.Resize(4);
+        assert(v[3].empty());
+        try {
+            v.PushBack("z"s);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        try {
+            v.At(4);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+
+        StaticSimpleVector<std::string, 4> other{ "a"s };
+        v.swap(other);
+        assert(v.GetSize() == 1 && v[0] == "a"s);
+        assert(other.GetSize() == 4 && other[2] == "y"s);
+        assert(v < other || other < v);
+        v.PopBack();
+        assert(v.IsEmpty());
+    }
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestRangeViews() {
+    std::cout << "TestRangeViews"s << std::endl;
+    {
+        const std::vector<int> source{ 1, 2, 3, 4, 5 };
+        SimpleVector<int> v(from_range, source);
+        assert(v == SimpleVector<int>({ 1, 2, 3, 4, 5 }));
+        assert(v.GetCapacity() == v.GetSize());
+        assert(v.size() == 5 && v.data() == &v[0]);
+
+        SimpleVector<int> copy(from_range, v);
+        assert(copy == v && copy.GetCapacity() == 5);
+    }
+    {
+        SimpleVector<int> v{ 1, 2, 3, 4, 5, 6 };
+        auto squares = v | Transform([](int x) { return x * x; });
+        assert(squares.size() == 6);
+        const SimpleVector<int> collected = squares | Collect();
+        assert(collected == SimpleVector<int>({ 1, 4, 9, 16, 25, 36 }));
+        assert(collected.GetCapacity() == 6);
+
+        // Фильтр не знает точного размера: память выделяется один раз под размер источника
+        const SimpleVector<std::string> strings = v
+            | Filter([](int x) { return x % 2 == 0; })
+            | Transform([](int x) { return std::to_string(x); })
+            | Collect();
+        assert(strings == SimpleVector<std::string>({ "2"s, "4"s, "6"s }));
+        assert(strings.GetCapacity() == v.GetSize());
+
+        // Временный вектор перемещается внутрь представления
+        const auto evens = Collect(SimpleVector<int>{ 7, 8, 9, 10 } | Filter([](int x) { return x % 2 == 0; }));
+        assert(evens == SimpleVector<int>({ 8, 10 }));
+    }
+    // Итераторы, возвращающие значения, не объявляются прямыми для старых алгоритмов
+    {
+        SimpleVector<int> v{ 1, 2, 3 };
+        const auto squares = v | Transform([](int x) { return x * x; });
+        const auto even_squares = squares | Filter([](int x) { return x % 2 == 0; });
+        const auto evens = v | Filter([](int x) { return x % 2 == 0; });
+        using SquareIterator = decltype(squares.begin());
+        using EvenSquareIterator = decltype(even_squares.begin());
+        static_assert(std::is_same_v<std::iterator_traits<SquareIterator>::iterator_category, std::input_iterator_tag>);
+        static_assert(std::is_same_v<std::iterator_traits<EvenSquareIterator>::iterator_category, std::input_iterator_tag>);
+        static_assert(std::is_same_v<std::iterator_traits<decltype(evens.begin())>::iterator_category, std::forward_iterator_tag>);
+#if __cplusplus >= 202002L
+        static_assert(std::forward_iterator<SquareIterator>);
+        static_assert(std::forward_iterator<EvenSquareIterator>);
+#endif
+        assert(Collect(even_squares) == SimpleVector<int>({ 4 }));
+    }
+#if __cplusplus >= 202002L
+    static_assert(std::ranges::contiguous_range<SimpleVector<int>>);
+    static_assert(std::ranges::sized_range<const SimpleVector<int>>);
+    {
+        const SimpleVector<int> v{ 1, 2, 3, 4 };
+        const SimpleVector<int> doubled(from_range, v | std::views::transform([](int x) { return 2 * x; }));
+        assert(doubled == SimpleVector<int>({ 2, 4, 6, 8 }));
+        assert(doubled.GetCapacity() == 4);
+    }
+#endif
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestVectorExpressions() {
+    std::cout << "TestVectorExpressions"s << std::endl;
+    const SimpleVector<double> a{ 1.0, 2.0, 3.0 };
+    const SimpleVector<double> b{ 4.0, 5.0, 6.0 };
+    const SimpleVector<double> c{ 0.5, 2.0, -1.0 };
+
+    const SimpleVector<double> r = a + b * c;
+    assert(r == SimpleVector<double>({ 3.0, 12.0, -3.0 }));
+    assert(r.GetCapacity() == 3);
+
+    const auto expression = (a - b) / 2.0 + 1.0;
+    assert(expression.size() == 3);
+    assert(Evaluate(expression) == SimpleVector<double>({ -0.5, -0.5, -0.5 }));
+    assert(Evaluate(2.0 * a) == SimpleVector<double>({ 2.0, 4.0, 6.0 }));
+
+    // Выражение - диапазон с известным размером
+    assert(Collect(a * a | Transform([](double x) { return x + 1; })) == SimpleVector<double>({ 2.0, 5.0, 10.0 }));
+
+    using ExpressionIterator = decltype((a + b).begin());
+    static_assert(std::is_same_v<std::iterator_traits<ExpressionIterator>::iterator_category, std::input_iterator_tag>);
+#if __cplusplus >= 202002L
+    static_assert(std::forward_iterator<ExpressionIterator>);
+#endif
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestStreamingLoader() {
+    std::cout << "TestStreamingLoader"s << std::endl;
+    const auto path = std::filesystem::temp_directory_path() / "simple_vector_loader_test.txt";
+    {
+        SimpleVector<int> expected;
+        {
+            std::ofstream out(path, std::ios::binary);
+            for (int i = 0; i < 10'000; ++i) {
+                const int value = (i % 3 == 0 ? -1 : 1) * i * 37;
+                expected.PushBack(value);
+                out << value << (i % 10 == 9 ? "\r\n"s : i % 2 == 0 ? " "s : "\t  "s);
+            }
+        }
+
+        // Маленькие блоки: числа разрываются границами блоков
+        StreamingLoadOptions options;
+        options.chunk_size = 7;
+        options.worker_count = 3;
+        options.size_hint = expected.GetSize();
+        LoadProgress last;
+        size_t calls = 0;
+        options.on_progress = [&](const LoadProgress& progress) {
+            assert(progress.bytes_read >= last.bytes_read && progress.elements_loaded >= last.elements_loaded);
+            last = progress;
+            ++calls;
+        };
+        const auto values = LoadTextNumbers<int>(path, options);
+        assert(values == expected);
+        assert(values.GetCapacity() == expected.GetSize());
+        assert(calls > 1);
+        assert(last.bytes_read == std::filesystem::file_size(path));
+        assert(last.elements_loaded == expected.GetSize());
+
+        assert(LoadTextNumbers<int>(path) == expected);
+    }
+    {
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "1.5 -2e3\n+7 0.25"s;
+        }
+        assert(LoadTextNumbers<double>(path) == SimpleVector<double>({ 1.5, -2000.0, 7.0, 0.25 }));
+
+        for (const std::string& text : { "1 2 3x 4"s, "1 +-5 2"s, "+"s, "1 + 2"s }) {
+            {
+                std::ofstream out(path, std::ios::binary);
+                out << text;
+            }
+            try {
+                LoadTextNumbers<int>(path);
+                assert(false);
+            }
+            catch (const std::invalid_argument&) {
+            }
+        }
+        try {
+            SimpleVector<double> values;
+            const std::string text = "+-5"s;
+            ParseNumbers(text.data(), text.data() + text.size(), values);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        {
+            SimpleVector<double> values;
+            const std::string text = "+.5 +3"s;
+            ParseNumbers(text.data(), text.data() + text.size(), values);
+            assert(values == SimpleVector<double>({ 0.5, 3.0 }));
+        }
+    }
+    {
+        std::FILE* stream = std::tmpfile();
+        assert(stream != nullptr);
+        std::fputs("10 20\n30", stream);
+        std::rewind(stream);
+        assert(LoadTextNumbers<unsigned>(stream) == SimpleVector<unsigned>({ 10, 20, 30 }));
+        std::fclose(stream);
+    }
+    {
+        SimpleVector<uint32_t> expected;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            expected.PushBack(i * 2654435761u);
+        }
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(expected.data()), expected.GetSize() * sizeof(uint32_t));
+        }
+        StreamingLoadOptions options;
+        options.chunk_size = 100;
+        const auto values = LoadBinaryNumbers<uint32_t>(path, options);
+        assert(values == expected);
+        assert(values.GetCapacity() == expected.GetSize());
+
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out << 'x';
+        }
+        try {
+            LoadBinaryNumbers<uint32_t>(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+
+#if defined(__unix__) || defined(__APPLE__)
+        // У канала нет размера: данные читаются без подсказки
+        const auto fifo_path = std::filesystem::temp_directory_path() / "simple_vector_loader_test.fifo";
+        std::filesystem::remove(fifo_path);
+        const int fifo_result = mkfifo(fifo_path.c_str(), 0600);
+        assert(fifo_result == 0);
+        std::thread writer([&] {
+            std::ofstream out(fifo_path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(expected.data()), expected.GetSize() * sizeof(uint32_t));
+        });
+        const auto from_fifo = LoadBinaryNumbers<uint32_t>(fifo_path, options);
+        writer.join();
+        std::filesystem::remove(fifo_path);
+        assert(from_fifo == expected);
+#endif
+    }
+    std::filesystem::remove(path);
+    std::cout << "Done!"s << std::endl;
+}
+
+void TestBufferPool() {
+    std::cout << "TestBufferPool"s << std::endl;
+    assert(BufferPool<int>::Current() == nullptr);
+    {
+        BufferPool<int> pool;
+        {
+            BufferPoolScope<int> scope(pool);
+            assert(BufferPool<int>::Current() == &pool);
+            // Первый вектор выделяет буферы 1, 2, ..., 128 и возвращает их в пул,
+            // следующие берут их из пула
+            for (int i = 0; i < 10; ++i) {
+                SimpleVector<int> v;
+                for (int j = 0; j < 100; ++j) {
+                    v.PushBack(j);
+                }
+                assert(v.GetCapacity() == 128 && v[99] == 99);
+            }
+            assert(pool.GetStats().misses == 8);
+            assert(pool.GetStats().hits == 8 * 9);
+            assert(pool.GetStats().GetHitRate() > 0.89);
+
+            // Пустые векторы не обращаются ни к куче, ни к пулу
+            {
+                const SimpleVector<int> empty;
+                SimpleVector<int> copy(empty);
+                copy.ShrinkToFit();
+                SimpleVector<int> zero(0);
+            }
+            assert(pool.GetStats().bypassed == 0);
+
+            // Вместимость не степень двойки - мимо пула
+            SimpleVector<int> odd(Reserve(5));
+            assert(pool.GetStats().bypassed == 1);
+
+            SimpleVector<int> v(64, 7);
+            const size_t pooled = pool.GetPooledBytes();
+            v.Recycle();
+            assert(v.IsEmpty() && v.GetCapacity() == 0);
+            assert(pool.GetPooledBytes() == pooled + 64 * sizeof(int));
+            v.PushBack(1);
+            assert(v[0] == 1);
+
+            {
+                BufferPool<int> nested;
+                BufferPoolScope<int> nested_scope(nested);
+                assert(BufferPool<int>::Current() == &nested);
+            }
+            assert(BufferPool<int>::Current() == &pool);
+        }
+        assert(BufferPool<int>::Current() == nullptr);
+        assert(pool.GetPooledBytes() > 0);
+        pool.Trim(0);
+        assert(pool.GetPooledBytes() == 0);
+    }
+    {
+        BufferPoolLimits limits;
+        limits.max_buffers_per_class = 1;
+        BufferPool<int> pool(limits);
+        BufferPoolScope<int> scope(pool);
+        {
+            SimpleVector<int> a(4);
+            SimpleVector<int> b(4);
+        }
+        assert(pool.GetStats().returned == 1 && pool.GetStats().dropped == 1);
+        assert(pool.GetPooledBytes() == 4 * sizeof(int));
+    }
+    {
+        BufferPool<std::string> pool;
+        BufferPoolScope<std::string> scope(pool);
+        for (int i = 0; i < 3; ++i) {
+            SimpleVector<std::string> v;
+            v.PushBack(std::string(100, 'a' + i));
+            v.PushBack("b"s);
+            assert(v[0] == std::string(100, 'a' + i) && v[1] == "b"s);
+        }
+        assert(pool.GetStats().hits == 4);
+    }
+    std::cout << "Done!"s << std::endl;
+}
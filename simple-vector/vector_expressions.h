@@ -0,0 +1,235 @@
+#pragma once
+#include "checked_iterator.h"
+#include "simple_vector.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Поэлементная арифметика над SimpleVector на шаблонах выражений.
+// a + b * c не вычисляет b * c во временный вектор, а строит дерево выражения;
+// при присваивании в SimpleVector результат считается одним циклом:
+// result[i] = a[i] + b[i] * c[i], память выделяется один раз.
+// Выражение ссылается на векторы-операнды и должно вычисляться, пока они живы:
+// auto e = MakeVector() + b; оставит висячую ссылку
+
+// Лист выражения: элементы вектора-операнда
+template <typename Type>
+class VectorTerminal {
+public:
+    using value_type = Type;
+
+    explicit VectorTerminal(const SimpleVector<Type>& vector) noexcept
+        :data_(vector.data()), size_(vector.GetSize())
+    {
+
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    const Type* data_;
+    size_t size_;
+};
+
+// Лист выражения: скаляр, размноженный до размера второго операнда
+template <typename Type>
+class VectorScalar {
+public:
+    using value_type = Type;
+
+    VectorScalar(Type value, size_t size) noexcept
+        :value_(std::move(value)), size_(size)
+    {
+
+    }
+
+    const Type& operator[](size_t) const noexcept {
+        return value_;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    Type value_;
+    size_t size_;
+};
+
+template <typename Expression>
+class VectorExpressionIterator;
+
+// Узел выражения: Op(lhs[i], rhs[i]) для каждого i.
+// Выражение - диапазон с известным размером, его можно передать в Collect или SimpleVector(from_range, ...)
+template <typename Lhs, typename Rhs, typename Op>
+class VectorBinaryExpression {
+public:
+    using value_type = std::decay_t<std::invoke_result_t<const Op&,
+        const typename Lhs::value_type&, const typename Rhs::value_type&>>;
+    using Iterator = VectorExpressionIterator<VectorBinaryExpression>;
+
+    VectorBinaryExpression(Lhs lhs, Rhs rhs)
+        :lhs_(std::move(lhs)), rhs_(std::move(rhs))
+    {
+        SIMPLE_VECTOR_CHECK(lhs_.size() == rhs_.size(), "vector sizes differ in element-wise operation");
+    }
+
+    value_type operator[](size_t index) const {
+        return op_(lhs_[index], rhs_[index]);
+    }
+
+    size_t size() const noexcept {
+        return lhs_.size();
+    }
+
+    Iterator begin() const noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() const noexcept {
+        return Iterator(this, size());
+    }
+
+    // Вычисляет выражение одним циклом в новый вектор
+    operator SimpleVector<value_type>() const {
+        return SimpleVector<value_type>(from_range, *this);
+    }
+
+private:
+    Lhs lhs_;
+    Rhs rhs_;
+    Op op_;
+};
+
+// Итератор по значениям выражения. operator* возвращает значение, а не ссылку, поэтому
+// для старых алгоритмов итератор однопроходный; в C++20 iterator_concept разрешает повторный обход
+template <typename Expression>
+class VectorExpressionIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::forward_iterator_tag;
+#endif
+    using value_type = typename Expression::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    VectorExpressionIterator() noexcept = default;
+
+    VectorExpressionIterator(const Expression* expression, size_t index) noexcept
+        :expression_(expression), index_(index)
+    {
+
+    }
+
+    reference operator*() const {
+        return (*expression_)[index_];
+    }
+
+    VectorExpressionIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    VectorExpressionIterator operator++(int) noexcept {
+        VectorExpressionIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    friend bool operator==(const VectorExpressionIterator& lhs, const VectorExpressionIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const VectorExpressionIterator& lhs, const VectorExpressionIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+private:
+    const Expression* expression_ = nullptr;
+    size_t index_ = 0;
+};
+
+template <typename T>
+struct IsVectorOperand : std::false_type {};
+
+template <typename Type>
+struct IsVectorOperand<SimpleVector<Type>> : std::true_type {};
+
+template <typename Lhs, typename Rhs, typename Op>
+struct IsVectorOperand<VectorBinaryExpression<Lhs, Rhs, Op>> : std::true_type {};
+
+// Вектор становится листом выражения, выражение используется как есть
+template <typename Type>
+VectorTerminal<Type> AsVectorOperand(const SimpleVector<Type>& vector) noexcept {
+    return VectorTerminal<Type>(vector);
+}
+
+template <typename Lhs, typename Rhs, typename Op>
+const VectorBinaryExpression<Lhs, Rhs, Op>& AsVectorOperand(const VectorBinaryExpression<Lhs, Rhs, Op>& expression) noexcept {
+    return expression;
+}
+
+template <typename T>
+using VectorOperandOf = std::decay_t<decltype(AsVectorOperand(std::declval<const T&>()))>;
+
+// Строит узел Op для двух векторов/выражений либо для вектора/выражения и скаляра
+template <typename Op, typename Lhs, typename Rhs>
+auto MakeVectorExpression(const Lhs& lhs, const Rhs& rhs) {
+    if constexpr (IsVectorOperand<Lhs>::value && IsVectorOperand<Rhs>::value) {
+        return VectorBinaryExpression<VectorOperandOf<Lhs>, VectorOperandOf<Rhs>, Op>(
+            AsVectorOperand(lhs), AsVectorOperand(rhs));
+    }
+    else if constexpr (IsVectorOperand<Lhs>::value) {
+        using Scalar = VectorScalar<typename VectorOperandOf<Lhs>::value_type>;
+        return VectorBinaryExpression<VectorOperandOf<Lhs>, Scalar, Op>(
+            AsVectorOperand(lhs), Scalar(rhs, lhs.size()));
+    }
+    else {
+        using Scalar = VectorScalar<typename VectorOperandOf<Rhs>::value_type>;
+        return VectorBinaryExpression<Scalar, VectorOperandOf<Rhs>, Op>(
+            Scalar(lhs, rhs.size()), AsVectorOperand(rhs));
+    }
+}
+
+// Оператор участвует в перегрузке, если хотя бы один операнд - вектор или выражение,
+// а другой - вектор, выражение или арифметический скаляр
+template <typename Lhs, typename Rhs>
+using EnableVectorOperator = std::enable_if_t<
+    (IsVectorOperand<Lhs>::value && (IsVectorOperand<Rhs>::value || std::is_arithmetic_v<Rhs>))
+    || (std::is_arithmetic_v<Lhs> && IsVectorOperand<Rhs>::value)>;
+
+template <typename Lhs, typename Rhs, typename = EnableVectorOperator<Lhs, Rhs>>
+auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return MakeVectorExpression<std::plus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = EnableVectorOperator<Lhs, Rhs>>
+auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return MakeVectorExpression<std::minus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = EnableVectorOperator<Lhs, Rhs>>
+auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return MakeVectorExpression<std::multiplies<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, typename = EnableVectorOperator<Lhs, Rhs>>
+auto operator/(const Lhs& lhs, const Rhs& rhs) {
+    return MakeVectorExpression<std::divides<>>(lhs, rhs);
+}
+
+// Вычисляет выражение в новый вектор; удобно вместе с auto
+template <typename Lhs, typename Rhs, typename Op>
+SimpleVector<typename VectorBinaryExpression<Lhs, Rhs, Op>::value_type> Evaluate(const VectorBinaryExpression<Lhs, Rhs, Op>& expression) {
+    return expression;
+}